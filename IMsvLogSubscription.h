@@ -0,0 +1,139 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Subscription Interface
+* @details		Structured log record and log subscription interface.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @warning		This file should not be included directly. It should be included in file which
+*					defines @ref MsvLogger macro and logging macros.
+*					Use file mlogging.h to include MLOGGING to your project or create your own one.
+* @see			IMsvLoggerProvider::Subscribe
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ILOG_SUBSCRIPTION_H
+#define MARSTECH_ILOG_SUBSCRIPTION_H
+
+
+/**************************************************************************************************//**
+* @brief		Log record.
+* @details	Structured log record received by @ref IMsvLogSubscription. Source location (file, line and
+*				function) is passed by log macros. When logger is called directly, file and line are parsed
+*				from "[file:line]: " prefix of message. The prefix is not part of payload.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		IMsvLogSubscription
+******************************************************************************************************/
+struct MsvLogRecord
+{
+	/**************************************************************************************************//**
+	* @brief		Time when record was logged.
+	******************************************************************************************************/
+	std::chrono::system_clock::time_point time;
+
+	/**************************************************************************************************//**
+	* @brief		Log level.
+	******************************************************************************************************/
+	MsvLogLevel level;
+
+	/**************************************************************************************************//**
+	* @brief		Logger name.
+	******************************************************************************************************/
+	std::string logger;
+
+	/**************************************************************************************************//**
+	* @brief		Source file (empty when it is not known).
+	******************************************************************************************************/
+	std::string file;
+
+	/**************************************************************************************************//**
+	* @brief		Source line (zero when it is not known).
+	******************************************************************************************************/
+	int line;
+
+	/**************************************************************************************************//**
+	* @brief		Source function (empty when it is not known).
+	******************************************************************************************************/
+	std::string function;
+
+	/**************************************************************************************************//**
+	* @brief		Formatted message (truncated when it does not fit to ring slot).
+	******************************************************************************************************/
+	std::string payload;
+
+	/**************************************************************************************************//**
+	* @brief		Id of thread which logged record.
+	******************************************************************************************************/
+	size_t threadId;
+
+	/**************************************************************************************************//**
+	* @brief		Number of records lost (overwritten before they were read) just before this record.
+	******************************************************************************************************/
+	uint64_t gap;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Log subscription interface.
+* @details	Live subscription to log records of logger provider. Records are passed through broadcast
+*				ring - producers never wait for subscribers. Subscriber which does not read records fast
+*				enough loses the oldest ones and it gets number of lost records (gap) instead.
+*				Subscription is cancelled when it is destroyed.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		IMsvLoggerProvider::Subscribe
+* @see		MsvLogRecord
+******************************************************************************************************/
+class IMsvLogSubscription
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvLogSubscription() {  }
+
+	/**************************************************************************************************//**
+	* @brief			Poll next record.
+	* @details		Returns the next record which matches subscription filter. It never blocks.
+	* @param[out]	record		Received record.
+	* @retval		true			When record was received.
+	* @retval		false			When there is no new record.
+	* @warning		One subscription must not be polled by more threads at once.
+	******************************************************************************************************/
+	virtual bool Poll(MsvLogRecord& record) = 0;
+
+	/**************************************************************************************************//**
+	* @brief		Get number of lost records.
+	* @returns	Number of records lost by this subscription (sum of gaps).
+	******************************************************************************************************/
+	virtual uint64_t GetLostCount() const = 0;
+};
+
+
+#endif // !MARSTECH_ILOG_SUBSCRIPTION_H
+
+/** @} */	//End of group MLOGGING.
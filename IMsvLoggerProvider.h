@@ -77,6 +77,17 @@ public:
 	******************************************************************************************************/
 	virtual std::shared_ptr<MsvLogger> GetLogger(const char* loggerName, const char* logFile, int maxLogFileSize, int maxLogFiles) const = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Register loggers.
+	* @details		Creates (pre-registers) all loggers with names in loggerNames at once. Loggers log to default
+	*					log file and they can be get by @ref GetLogger later. Already existing loggers are kept.
+	* @param[in]	loggerNames		Names of loggers to create.
+	* @retval		true				When all loggers exist.
+	* @retval		false				When some loggers could not be created.
+	* @see			GetLogger(const char*) const
+	******************************************************************************************************/
+	virtual bool RegisterLoggers(const std::vector<std::string>& loggerNames) const = 0;
+
 	/**************************************************************************************************//**
 	* @brief			Set log level.
 	* @details		Sets log level for logging to all logger. Default level is INFO.
@@ -85,6 +96,18 @@ public:
 	*					is required.
 	******************************************************************************************************/
 	virtual void SetLogLevel(MsvLogLevel logLevel) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Subscribe to log records.
+	* @details		Creates live subscription to records (logged after this call) of all loggers created by
+	*					provider. Records must pass logger level to be received. While there is no subscription,
+	*					records are not passed to subscriptions at all (just level of subscription sink is checked).
+	* @param[in]	loggerName		Name of logger to receive records of. Empty name means all loggers.
+	* @param[in]	logLevel			Minimal level of received records.
+	* @returns		Log subscription or nullptr when provider does not support it.
+	* @see			IMsvLogSubscription
+	******************************************************************************************************/
+	virtual std::shared_ptr<IMsvLogSubscription> Subscribe(const char* loggerName = "", MsvLogLevel logLevel = spdlog::level::trace) = 0;
 };
 
 
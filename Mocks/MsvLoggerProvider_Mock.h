@@ -22,6 +22,9 @@ public:
 
 	MOCK_CONST_METHOD1(GetLogger, std::shared_ptr<MsvLogger>(const char* loggerName));
 	MOCK_CONST_METHOD4(GetLogger, std::shared_ptr<MsvLogger>(const char* loggerName, const char* logFile, int maxLogFileSize, int maxLogFiles));
+	MOCK_CONST_METHOD1(RegisterLoggers, bool(const std::vector<std::string>& loggerNames));
+	MOCK_METHOD1(SetLogLevel, void(MsvLogLevel logLevel));
+	MOCK_METHOD2(Subscribe, std::shared_ptr<IMsvLogSubscription>(const char* loggerName, MsvLogLevel logLevel));
 };
 
 
@@ -0,0 +1,474 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Admission Control
+* @details		Priority-aware admission control of log records with global in-flight limit.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvLoggerProvider::SetAdmissionPolicy
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ADMISSION_CONTROL_SINK_H
+#define MARSTECH_ADMISSION_CONTROL_SINK_H
+
+
+#include "mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "spdlog/sinks/sink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Admission policy.
+* @details	Defines in-flight limit - maximum size of records which are inside sinks at once (they wait
+*				for sink lock or they are being written) - and degradation order - fraction of the limit which
+*				can be used by records of each level. It is concurrency cap weighted by record size, not
+*				a queue: admitted records are still written synchronously by logging threads (they wait for
+*				sink lock), dropped records do not wait at all. Records with level error and critical are
+*				never dropped (they can use whole limit and even exceed it - they wait for sink as without
+*				admission control).
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvAdmissionLimiter
+* @see		MsvAdmissionControlSink
+* @see		MsvAdmissionReporter
+******************************************************************************************************/
+struct MsvAdmissionPolicy
+{
+	/**************************************************************************************************//**
+	* @brief			Admission policy constructor.
+	* @details		Default degradation order drops trace first (at 25% of the limit), then debug (50%),
+	*					info (75%) and warning (100%).
+	* @param[in]	limit		In-flight limit (in bytes). Zero turns admission control off.
+	******************************************************************************************************/
+	MsvAdmissionPolicy(size_t limit = 0):
+		inFlightLimit(limit),
+		reportInterval(std::chrono::seconds(60))
+	{
+		levelLimits[spdlog::level::trace] = 0.25;
+		levelLimits[spdlog::level::debug] = 0.5;
+		levelLimits[spdlog::level::info] = 0.75;
+		levelLimits[spdlog::level::warn] = 1.0;
+		levelLimits[spdlog::level::err] = 1.0;
+		levelLimits[spdlog::level::critical] = 1.0;
+		levelLimits[spdlog::level::off] = 1.0;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		In-flight limit - maximum size of records inside sinks at once (in bytes).
+	******************************************************************************************************/
+	size_t inFlightLimit;
+
+	/**************************************************************************************************//**
+	* @brief		Level limits.
+	* @details	Fraction of in-flight limit which can be used when record with level is admitted. Limits
+	*				for error and critical are ignored (they are never dropped).
+	******************************************************************************************************/
+	double levelLimits[spdlog::level::n_levels];
+
+	/**************************************************************************************************//**
+	* @brief		Interval of dropped records summary.
+	******************************************************************************************************/
+	std::chrono::milliseconds reportInterval;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Admission limiter.
+* @details	Global (shared by all admission control sinks of logger provider) limit of records in flight
+*				(inside sinks). It also counts dropped records. Policy can be changed at any time - all sinks
+*				sharing the limiter use the new limits (and dropped counts are kept for next summary).
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvAdmissionPolicy
+* @see		MsvAdmissionControlSink
+******************************************************************************************************/
+class MsvAdmissionLimiter
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Admission limiter constructor.
+	* @param[in]	policy		Admission policy.
+	******************************************************************************************************/
+	MsvAdmissionLimiter(const MsvAdmissionPolicy& policy):
+		m_inFlight(0)
+	{
+		for (int level = 0; level < spdlog::level::n_levels; ++level)
+		{
+			m_dropped[level].store(0, std::memory_order_relaxed);
+		}
+		SetPolicy(policy);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set policy.
+	* @details		Changes limits of all sinks sharing the limiter. Records already in flight are not
+	*					affected. In-flight limit zero admits all records.
+	* @param[in]	policy		Admission policy.
+	******************************************************************************************************/
+	void SetPolicy(const MsvAdmissionPolicy& policy)
+	{
+		for (int level = 0; level < spdlog::level::n_levels; ++level)
+		{
+			if (level >= spdlog::level::err || !policy.inFlightLimit)
+			{
+				m_limits[level].store(SIZE_MAX, std::memory_order_relaxed);
+			}
+			else
+			{
+				m_limits[level].store(static_cast<size_t>(static_cast<double>(policy.inFlightLimit) * policy.levelLimits[level]), std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Acquire in-flight limit.
+	* @details		Reserves part of in-flight limit for record or counts it as dropped.
+	* @param[in]	level		Record level.
+	* @param[in]	size		Record size (in bytes).
+	* @retval		true		When limit was reserved - release it by @ref Release after record is written.
+	* @retval		false		When record has to be dropped.
+	******************************************************************************************************/
+	bool Acquire(MsvLogLevel level, size_t size)
+	{
+		size_t inFlight = m_inFlight.fetch_add(size, std::memory_order_relaxed) + size;
+		if (inFlight > m_limits[level].load(std::memory_order_relaxed))
+		{
+			m_inFlight.fetch_sub(size, std::memory_order_relaxed);
+			m_dropped[level].fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Release in-flight limit.
+	* @param[in]	size		Record size (in bytes).
+	******************************************************************************************************/
+	void Release(size_t size)
+	{
+		m_inFlight.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Take dropped records summary.
+	* @details		When some records were dropped, it resets dropped counts and creates summary:
+	*					"dropped records: trace <n>, debug <n>, info <n>, warning <n>".
+	* @param[out]	summary		Dropped records summary.
+	* @retval		true			When summary should be logged.
+	* @retval		false			When nothing has been dropped.
+	* @see			MsvAdmissionReporter
+	******************************************************************************************************/
+	bool TakeDroppedSummary(std::string& summary)
+	{
+		uint64_t dropped[spdlog::level::n_levels];
+		uint64_t total = 0;
+		for (int level = 0; level < spdlog::level::n_levels; ++level)
+		{
+			dropped[level] = m_dropped[level].exchange(0, std::memory_order_relaxed);
+			total += dropped[level];
+		}
+
+		if (!total)
+		{
+			return false;
+		}
+
+		summary = "dropped records: trace " + std::to_string(dropped[spdlog::level::trace]) +
+			", debug " + std::to_string(dropped[spdlog::level::debug]) +
+			", info " + std::to_string(dropped[spdlog::level::info]) +
+			", warning " + std::to_string(dropped[spdlog::level::warn]);
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get in-flight records size.
+	* @returns	Size of all records inside sinks (in bytes).
+	******************************************************************************************************/
+	size_t GetInFlight() const
+	{
+		return m_inFlight.load(std::memory_order_relaxed);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Level limits (in bytes).
+	******************************************************************************************************/
+	std::atomic<size_t> m_limits[spdlog::level::n_levels];
+
+	/**************************************************************************************************//**
+	* @brief		Size of records inside sinks (in bytes).
+	******************************************************************************************************/
+	std::atomic<size_t> m_inFlight;
+
+	/**************************************************************************************************//**
+	* @brief		Dropped records counts (since the last summary).
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_dropped[spdlog::level::n_levels];
+};
+
+
+/**************************************************************************************************//**
+* @brief		Admission control sink.
+* @details	Sink which passes records to its real sink only when they fit to @ref MsvAdmissionLimiter.
+*				Records are in flight while they wait for real sink (its lock) and while they are written.
+*				When logging volume spikes, low priority records are dropped instead of stalling threads
+*				(admitted records still wait for real sink - there is no queue).
+*				Dropped records are counted by limiter and reported by @ref MsvAdmissionReporter.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvAdmissionPolicy
+* @see		MsvAdmissionLimiter
+* @see		MsvAdmissionReporter
+******************************************************************************************************/
+class MsvAdmissionControlSink:
+	public spdlog::sinks::sink
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Estimated overhead of one record in flight (in bytes).
+	******************************************************************************************************/
+	static const size_t RecordOverhead = 128;
+
+	/**************************************************************************************************//**
+	* @brief			Admission control sink constructor.
+	* @param[in]	spSink		Real sink.
+	* @param[in]	spLimiter	Admission limiter (shared by all sinks of logger provider).
+	******************************************************************************************************/
+	MsvAdmissionControlSink(std::shared_ptr<spdlog::sinks::sink> spSink, std::shared_ptr<MsvAdmissionLimiter> spLimiter):
+		m_spSink(spSink),
+		m_spLimiter(spLimiter)
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvAdmissionControlSink() {  }
+
+	/**************************************************************************************************//**
+	* @brief			Log message.
+	* @details		Passes message to real sink when it fits to in-flight limit, drops it otherwise.
+	* @param[in]	msg		Message to log.
+	******************************************************************************************************/
+	virtual void log(const spdlog::details::log_msg& msg) override
+	{
+		size_t size = msg.payload.size() + RecordOverhead;
+		if (!m_spLimiter->Acquire(msg.level, size))
+		{
+			return;
+		}
+
+		try
+		{
+			m_spSink->log(msg);
+		}
+		catch (...)
+		{
+			m_spLimiter->Release(size);
+			throw;
+		}
+		m_spLimiter->Release(size);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Flush real sink.
+	******************************************************************************************************/
+	virtual void flush() override
+	{
+		m_spSink->flush();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log pattern.
+	* @param[in]	pattern		Log pattern.
+	******************************************************************************************************/
+	virtual void set_pattern(const std::string& pattern) override
+	{
+		m_spSink->set_pattern(pattern);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log formatter.
+	* @param[in]	sink_formatter		Log formatter.
+	******************************************************************************************************/
+	virtual void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+	{
+		m_spSink->set_formatter(std::move(sink_formatter));
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get real sink.
+	* @returns	Real sink (records logged to it directly are not subject to admission control).
+	******************************************************************************************************/
+	std::shared_ptr<spdlog::sinks::sink> GetSink() const
+	{
+		return m_spSink;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Real sink.
+	******************************************************************************************************/
+	std::shared_ptr<spdlog::sinks::sink> m_spSink;
+
+	/**************************************************************************************************//**
+	* @brief		Admission limiter.
+	******************************************************************************************************/
+	std::shared_ptr<MsvAdmissionLimiter> m_spLimiter;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Admission reporter.
+* @details	Runs thread which takes dropped records summary from @ref MsvAdmissionLimiter once per report
+*				interval and passes it to report function (when something was dropped). Summary is reported
+*				for the last time when reporter is destroyed.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvAdmissionPolicy
+* @see		MsvAdmissionLimiter
+******************************************************************************************************/
+class MsvAdmissionReporter
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Report function type.
+	******************************************************************************************************/
+	typedef std::function<void(const std::string& summary)> ReportFunction;
+
+	/**************************************************************************************************//**
+	* @brief			Admission reporter constructor.
+	* @details		Starts reporting thread.
+	* @param[in]	spLimiter	Admission limiter.
+	* @param[in]	interval		Report interval (at least 1 ms).
+	* @param[in]	report		Function which logs dropped records summary.
+	******************************************************************************************************/
+	MsvAdmissionReporter(std::shared_ptr<MsvAdmissionLimiter> spLimiter, std::chrono::milliseconds interval, ReportFunction report):
+		m_spLimiter(spLimiter),
+		m_interval(std::max(interval, std::chrono::milliseconds(1))),
+		m_report(report),
+		m_stop(false)
+	{
+		m_thread = std::thread([this]()
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			while (!m_condition.wait_for(lock, m_interval, [this]() { return m_stop; }))
+			{
+				Report();
+			}
+		});
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Admission reporter destructor.
+	* @details	Stops reporting thread and reports dropped records for the last time.
+	******************************************************************************************************/
+	~MsvAdmissionReporter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+
+		Report();
+	}
+
+	MsvAdmissionReporter(const MsvAdmissionReporter&) = delete;
+	MsvAdmissionReporter& operator= (const MsvAdmissionReporter&) = delete;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Report dropped records (when something was dropped).
+	******************************************************************************************************/
+	void Report()
+	{
+		std::string summary;
+		if (m_spLimiter->TakeDroppedSummary(summary))
+		{
+			m_report(summary);
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Admission limiter.
+	******************************************************************************************************/
+	std::shared_ptr<MsvAdmissionLimiter> m_spLimiter;
+
+	/**************************************************************************************************//**
+	* @brief		Report interval.
+	******************************************************************************************************/
+	std::chrono::milliseconds m_interval;
+
+	/**************************************************************************************************//**
+	* @brief		Report function.
+	******************************************************************************************************/
+	ReportFunction m_report;
+
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Stop condition.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Stop flag.
+	******************************************************************************************************/
+	bool m_stop;
+
+	/**************************************************************************************************//**
+	* @brief		Reporting thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+};
+
+
+#endif // !MARSTECH_ADMISSION_CONTROL_SINK_H
+
+/** @} */	//End of group MLOGGING.
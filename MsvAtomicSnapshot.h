@@ -0,0 +1,198 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Atomic Snapshot
+* @details		Immutable snapshot published by atomic pointer swap with epoch-based reclamation.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvLoggingConfig
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ATOMIC_SNAPSHOT_H
+#define MARSTECH_ATOMIC_SNAPSHOT_H
+
+
+#include "mheaders/MsvCompiler.h"
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Atomic snapshot.
+* @details	Holds immutable snapshot (e.g. configuration) which can be read by any number of threads
+*				without any lock and replaced (published) by another thread at any time.
+*				Readers pin current epoch (one counter of two) before they load snapshot pointer. Writer
+*				swaps pointer and then flips epoch twice - each time it waits until readers of previous
+*				epoch leave. After that no reader can hold old snapshot and it is deleted.
+*				Readers never wait, only writers (publishing is rare) do.
+* @author	Martin Svoboda
+* @date		18.10.2026
+******************************************************************************************************/
+template<typename T>
+class MsvAtomicSnapshot
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Snapshot guard.
+	* @details	Keeps snapshot alive while guard exists. Create it on stack and keep it short.
+	******************************************************************************************************/
+	class Guard
+	{
+	public:
+		/**************************************************************************************************//**
+		* @brief			Snapshot guard constructor.
+		* @details		Pins current epoch and loads snapshot.
+		* @param[in]	snapshot		Atomic snapshot to read.
+		******************************************************************************************************/
+		Guard(const MsvAtomicSnapshot& snapshot):
+			m_pReaders(&snapshot.m_readers[snapshot.m_epoch.load() & 1])
+		{
+			m_pReaders->fetch_add(1);
+			m_pValue = snapshot.m_pValue.load();
+		}
+
+		/**************************************************************************************************//**
+		* @brief		Snapshot guard destructor.
+		* @details	Unpins epoch (snapshot can be deleted when it is not current anymore).
+		******************************************************************************************************/
+		~Guard()
+		{
+			m_pReaders->fetch_sub(1, std::memory_order_release);
+		}
+
+		Guard(const Guard&) = delete;
+		Guard& operator= (const Guard&) = delete;
+
+		/**************************************************************************************************//**
+		* @brief		Get snapshot.
+		* @returns	Snapshot (might be nullptr when nothing has been published yet).
+		******************************************************************************************************/
+		const T* Get() const
+		{
+			return m_pValue;
+		}
+
+		/**************************************************************************************************//**
+		* @brief		Access snapshot.
+		* @returns	Snapshot.
+		******************************************************************************************************/
+		const T* operator->() const
+		{
+			return m_pValue;
+		}
+
+	protected:
+		/**************************************************************************************************//**
+		* @brief		Readers counter of pinned epoch.
+		******************************************************************************************************/
+		std::atomic<uint64_t>* m_pReaders;
+
+		/**************************************************************************************************//**
+		* @brief		Snapshot.
+		******************************************************************************************************/
+		const T* m_pValue;
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Atomic snapshot constructor.
+	* @param[in]	pValue		Initial snapshot (ownership is taken), it might be nullptr.
+	******************************************************************************************************/
+	MsvAtomicSnapshot(const T* pValue = nullptr):
+		m_pValue(pValue),
+		m_epoch(0)
+	{
+		m_readers[0].store(0);
+		m_readers[1].store(0);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Atomic snapshot destructor.
+	* @details	Deletes current snapshot. There must not be any guard.
+	******************************************************************************************************/
+	~MsvAtomicSnapshot()
+	{
+		delete m_pValue.load();
+	}
+
+	MsvAtomicSnapshot(const MsvAtomicSnapshot&) = delete;
+	MsvAtomicSnapshot& operator= (const MsvAtomicSnapshot&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Publish snapshot.
+	* @details		Replaces current snapshot, waits until no reader can use the old one and deletes it.
+	* @param[in]	pValue		New snapshot (ownership is taken).
+	******************************************************************************************************/
+	void Publish(const T* pValue)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		const T* pOldValue = m_pValue.exchange(pValue);
+
+		for (int flip = 0; flip < 2; ++flip)
+		{
+			uint64_t epoch = m_epoch.fetch_add(1);
+			while (m_readers[epoch & 1].load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		delete pOldValue;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Writers locking object.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Current snapshot.
+	******************************************************************************************************/
+	std::atomic<const T*> m_pValue;
+
+	/**************************************************************************************************//**
+	* @brief		Current epoch.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_epoch;
+
+	/**************************************************************************************************//**
+	* @brief		Readers counters (by epoch parity).
+	******************************************************************************************************/
+	mutable std::atomic<uint64_t> m_readers[2];
+};
+
+
+#endif // !MARSTECH_ATOMIC_SNAPSHOT_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,218 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Lazy Sink
+* @details		Sink which creates (opens) its real sink on the first logged record.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvLoggerProvider
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LAZY_SINK_H
+#define MARSTECH_LAZY_SINK_H
+
+
+#include "mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "spdlog/sinks/sink.h"
+#include "spdlog/pattern_formatter.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Lazy sink.
+* @details	Sink which delays creation of its real sink (e.g. opening log file) until the first record
+*				is logged. Records are passed to sinks only when they pass logger level check, so loggers
+*				which never log anything do not cost any file handle or I/O.
+*				Pattern and formatter set before the real sink is created are stored and applied to the
+*				real sink when it is created.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLoggerProvider::SetLazySinkOpening
+******************************************************************************************************/
+class MsvLazySink:
+	public spdlog::sinks::sink
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Real sink factory type.
+	* @details		Creates real sink. It might throw an exception (e.g. when log file can not be opened).
+	******************************************************************************************************/
+	typedef std::function<std::shared_ptr<spdlog::sinks::sink>()> SinkFactory;
+
+	/**************************************************************************************************//**
+	* @brief			Lazy sink constructor.
+	* @param[in]	sinkFactory		Factory to create real sink. It is called when the first record is logged.
+	******************************************************************************************************/
+	MsvLazySink(SinkFactory sinkFactory):
+		m_sinkFactory(sinkFactory),
+		m_opened(false)
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvLazySink() {  }
+
+	/**************************************************************************************************//**
+	* @brief			Log message.
+	* @details		Creates real sink (when it has not been created yet) and passes message to it.
+	* @param[in]	msg		Message to log.
+	* @throws		spdlog::spdlog_ex	When real sink can not be created (it is tried again with next record).
+	******************************************************************************************************/
+	virtual void log(const spdlog::details::log_msg& msg) override
+	{
+		if (!m_opened.load(std::memory_order_acquire))
+		{
+			Open();
+		}
+
+		m_spSink->log(msg);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Flush real sink (when it has been created).
+	******************************************************************************************************/
+	virtual void flush() override
+	{
+		if (m_opened.load(std::memory_order_acquire))
+		{
+			m_spSink->flush();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log pattern.
+	* @param[in]	pattern		Log pattern.
+	******************************************************************************************************/
+	virtual void set_pattern(const std::string& pattern) override
+	{
+		set_formatter(std::unique_ptr<spdlog::formatter>(new spdlog::pattern_formatter(pattern)));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log formatter.
+	* @details		Passes formatter to real sink or stores it until real sink is created.
+	* @param[in]	sink_formatter		Log formatter.
+	******************************************************************************************************/
+	virtual void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (m_opened.load(std::memory_order_relaxed))
+		{
+			m_spSink->set_formatter(std::move(sink_formatter));
+		}
+		else
+		{
+			m_spFormatter = std::move(sink_formatter);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Check if real sink has been created.
+	* @retval	true		When real sink has been created.
+	* @retval	false		When no record has been logged yet.
+	******************************************************************************************************/
+	bool IsOpened() const
+	{
+		return m_opened.load(std::memory_order_acquire);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Create real sink.
+	* @details	Creates real sink and applies stored formatter to it.
+	* @throws	spdlog::spdlog_ex	When real sink can not be created.
+	******************************************************************************************************/
+	void Open()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (m_opened.load(std::memory_order_relaxed))
+		{
+			//created by another thread
+			return;
+		}
+
+		std::shared_ptr<spdlog::sinks::sink> spSink = m_sinkFactory();
+		if (!spSink)
+		{
+			throw spdlog::spdlog_ex("MsvLazySink: failed creating sink");
+		}
+
+		if (m_spFormatter)
+		{
+			spSink->set_formatter(std::move(m_spFormatter));
+		}
+
+		m_spSink = spSink;
+		m_opened.store(true, std::memory_order_release);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	* @details	Synchronizes creation of real sink and setting formatter.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Real sink factory.
+	******************************************************************************************************/
+	SinkFactory m_sinkFactory;
+
+	/**************************************************************************************************//**
+	* @brief		Real sink opened flag.
+	* @details	Set (with release semantic) when real sink has been created.
+	******************************************************************************************************/
+	std::atomic<bool> m_opened;
+
+	/**************************************************************************************************//**
+	* @brief		Real sink (nullptr until the first record is logged).
+	******************************************************************************************************/
+	std::shared_ptr<spdlog::sinks::sink> m_spSink;
+
+	/**************************************************************************************************//**
+	* @brief		Stored formatter.
+	* @details	Formatter set before real sink was created.
+	******************************************************************************************************/
+	std::unique_ptr<spdlog::formatter> m_spFormatter;
+};
+
+
+#endif // !MARSTECH_LAZY_SINK_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,213 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging File Pool
+* @details		Bounded pool of opened log files with approximate LRU eviction.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvLoggerProvider::SetMaxOpenLogFiles
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOG_FILE_POOL_H
+#define MARSTECH_LOG_FILE_POOL_H
+
+
+#include "mheaders/MsvCompiler.h"
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Pooled log file interface.
+* @details	Interface of log file (sink) which can be closed by @ref MsvLogFilePool. Closed log file is
+*				opened again when next record is logged to it.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogFilePool
+******************************************************************************************************/
+class IMsvPooledLogFile
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvPooledLogFile() {  }
+
+	/**************************************************************************************************//**
+	* @brief		Take referenced flag.
+	* @details	Returns and clears flag which is set when record is logged to log file.
+	* @retval	true		When log file has been used since the last call.
+	* @retval	false		When log file has not been used.
+	******************************************************************************************************/
+	virtual bool TakeReferenced() = 0;
+
+	/**************************************************************************************************//**
+	* @brief		Try close log file.
+	* @details	Closes log file when it is not just being used (it must not block).
+	* @retval	true		When log file was closed.
+	* @retval	false		When log file is being used.
+	******************************************************************************************************/
+	virtual bool TryCloseFile() = 0;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Log file pool.
+* @details	Limits number of opened log files. When log file is opened and limit is reached, the least
+*				recently used log file is closed (CLOCK algorithm - logging just sets referenced flag of
+*				log file, pool clears flags while it looks for log file to close). Log files which are
+*				being written are skipped, so limit might be exceeded for a while when all log files are busy.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		IMsvPooledLogFile
+* @see		MsvRotatingFileSink
+******************************************************************************************************/
+class MsvLogFilePool
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Log file pool constructor.
+	* @param[in]	maxOpenFiles		Maximum number of opened log files.
+	******************************************************************************************************/
+	MsvLogFilePool(size_t maxOpenFiles):
+		m_maxOpenFiles(std::max<size_t>(maxOpenFiles, 1)),
+		m_hand(0),
+		m_evictions(0)
+	{
+	}
+
+	MsvLogFilePool(const MsvLogFilePool&) = delete;
+	MsvLogFilePool& operator= (const MsvLogFilePool&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Log file opened.
+	* @details		Adds log file to pool and closes the least recently used one when limit is reached.
+	*					Log file which is already in pool (e.g. it was closed by itself and opened again) is not
+	*					added again.
+	* @param[in]	pFile		Opened log file.
+	* @warning		Log file (its lock) must not be closed by another thread while it is called.
+	******************************************************************************************************/
+	void Opened(IMsvPooledLogFile* pFile)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (std::find(m_openFiles.begin(), m_openFiles.end(), pFile) != m_openFiles.end())
+		{
+			return;
+		}
+
+		//two rounds - the first one might just clear referenced flags
+		for (size_t step = 0; m_openFiles.size() >= m_maxOpenFiles && step < 2 * m_openFiles.size(); ++step)
+		{
+			m_hand %= m_openFiles.size();
+			IMsvPooledLogFile* pCandidate = m_openFiles[m_hand];
+
+			if (pCandidate == pFile || pCandidate->TakeReferenced() || !pCandidate->TryCloseFile())
+			{
+				++m_hand;
+				continue;
+			}
+
+			m_openFiles[m_hand] = m_openFiles.back();
+			m_openFiles.pop_back();
+			++m_evictions;
+		}
+
+		m_openFiles.push_back(pFile);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Log file closed.
+	* @details		Removes log file from pool (e.g. when it is destroyed).
+	* @param[in]	pFile		Closed log file.
+	******************************************************************************************************/
+	void Closed(IMsvPooledLogFile* pFile)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_openFiles.erase(std::remove(m_openFiles.begin(), m_openFiles.end(), pFile), m_openFiles.end());
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get number of opened log files.
+	* @returns	Number of opened log files.
+	******************************************************************************************************/
+	size_t GetOpenCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		return m_openFiles.size();
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get number of evictions.
+	* @returns	Number of log files closed by pool.
+	******************************************************************************************************/
+	uint64_t GetEvictions() const
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		return m_evictions;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum number of opened log files.
+	******************************************************************************************************/
+	size_t m_maxOpenFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Opened log files.
+	******************************************************************************************************/
+	std::vector<IMsvPooledLogFile*> m_openFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Clock hand (index of the next eviction candidate).
+	******************************************************************************************************/
+	size_t m_hand;
+
+	/**************************************************************************************************//**
+	* @brief		Number of log files closed by pool.
+	******************************************************************************************************/
+	uint64_t m_evictions;
+};
+
+
+#endif // !MARSTECH_LOG_FILE_POOL_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,303 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Index Reader
+* @details		Reader of log files written with sparse time/level index.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvRotatingFileSink
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOG_INDEX_READER_H
+#define MARSTECH_LOG_INDEX_READER_H
+
+
+#include "MsvRotatingFileSink.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Log index reader.
+* @details	Uses sparse index written by @ref MsvRotatingFileSink to find only blocks of log file which
+*				may contain records from requested time range and with requested level. Only these blocks
+*				are read from log file - other blocks are skipped (seek). Parts of log file which are not
+*				covered by index (e.g. the last not finished block or log written before index was turned
+*				on) are always returned - they might contain requested records.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvRotatingFileSink
+* @see		MsvLogIndexEntry
+******************************************************************************************************/
+class MsvLogIndexReader
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Log index reader constructor.
+	* @param[in]	logFileName		Log file name (path). Index is read from "<log file>.idx".
+	******************************************************************************************************/
+	MsvLogIndexReader(const std::string& logFileName):
+		m_logFileName(logFileName),
+		m_logFileSize(0)
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Load index.
+	* @details	Reads whole index file (it is small - one entry per block) and size of log file.
+	* @retval	true		When log file exists (index file is optional - whole file is one unknown block).
+	* @retval	false		When log file does not exist.
+	******************************************************************************************************/
+	bool Load()
+	{
+		m_entries.clear();
+		m_logFileSize = 0;
+
+		std::ifstream logFile(m_logFileName, std::ios::binary | std::ios::ate);
+		if (!logFile.good())
+		{
+			return false;
+		}
+		m_logFileSize = static_cast<uint64_t>(logFile.tellg());
+
+		std::ifstream indexFile(MsvRotatingFileSink::CalcIndexFileName(m_logFileName), std::ios::binary);
+		MsvLogIndexEntry entry;
+		while (indexFile.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+		{
+			//ignore entries of log file which was truncated or entries out of order (corrupted index)
+			if (entry.offset + entry.length <= m_logFileSize && (m_entries.empty() || entry.offset >= m_entries.back().offset + m_entries.back().length))
+			{
+				m_entries.push_back(entry);
+			}
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Find blocks.
+	* @details		Finds blocks which may contain records from time range [from, to] with level equal or
+	*					higher than minLevel. Blocks not covered by index are returned with all levels set.
+	* @param[in]	from			Time range begin.
+	* @param[in]	to				Time range end.
+	* @param[in]	minLevel		Minimal level of records.
+	* @returns		Blocks ordered by offset in log file.
+	******************************************************************************************************/
+	std::vector<MsvLogIndexEntry> FindBlocks(spdlog::log_clock::time_point from, spdlog::log_clock::time_point to, MsvLogLevel minLevel = spdlog::level::trace) const
+	{
+		int64_t fromTime = GetTime(from);
+		int64_t toTime = GetTime(to);
+		uint32_t levelMask = ~((1u << static_cast<uint32_t>(minLevel)) - 1u);
+
+		std::vector<MsvLogIndexEntry> blocks;
+		uint64_t position = 0;
+
+		for (const MsvLogIndexEntry& entry : m_entries)
+		{
+			AddUnknownBlock(blocks, position, entry.offset);
+
+			if (entry.lastTime >= fromTime && entry.firstTime <= toTime && (entry.levelMask & levelMask))
+			{
+				blocks.push_back(entry);
+			}
+
+			position = entry.offset + entry.length;
+		}
+
+		AddUnknownBlock(blocks, position, m_logFileSize);
+
+		return blocks;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Read lines.
+	* @details		Reads all lines of blocks found by @ref FindBlocks. Blocks are not filtered by lines, so
+	*					returned lines might be from (slightly) wider time range or with lower level.
+	* @param[in]	from			Time range begin.
+	* @param[in]	to				Time range end.
+	* @param[in]	minLevel		Minimal level of records.
+	* @returns		Lines of found blocks (without end of line).
+	******************************************************************************************************/
+	std::vector<std::string> ReadLines(spdlog::log_clock::time_point from, spdlog::log_clock::time_point to, MsvLogLevel minLevel = spdlog::level::trace) const
+	{
+		std::vector<std::string> lines;
+
+		std::ifstream logFile(m_logFileName, std::ios::binary);
+		if (!logFile.good())
+		{
+			return lines;
+		}
+
+		std::string block;
+		//line which is not finished at the end of block (it continues in the next block when it follows)
+		std::string partialLine;
+		uint64_t partialLineEnd = 0;
+		for (const MsvLogIndexEntry& entry : FindBlocks(from, to, minLevel))
+		{
+			block.resize(entry.length);
+			logFile.seekg(static_cast<std::streamoff>(entry.offset));
+			if (!logFile.read(&block[0], static_cast<std::streamsize>(entry.length)))
+			{
+				break;
+			}
+
+			if (!partialLine.empty() && entry.offset != partialLineEnd)
+			{
+				AddLine(lines, partialLine);
+				partialLine.clear();
+			}
+
+			//log file which is being written (or which was not closed) ends with zeros of preallocated chunk
+			size_t begin = 0;
+			while (begin < block.size() && block[begin] != '\0')
+			{
+				size_t end = block.find('\n', begin);
+				if (end == std::string::npos)
+				{
+					partialLine.append(block, begin, block.find('\0', begin) - begin);
+					partialLineEnd = entry.offset + entry.length;
+					break;
+				}
+
+				partialLine.append(block, begin, end - begin);
+				AddLine(lines, partialLine);
+				partialLine.clear();
+				begin = end + 1;
+			}
+		}
+
+		if (!partialLine.empty())
+		{
+			AddLine(lines, partialLine);
+		}
+
+		return lines;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get index entries.
+	* @returns	All loaded index entries.
+	******************************************************************************************************/
+	const std::vector<MsvLogIndexEntry>& GetEntries() const
+	{
+		return m_entries;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief				Add line.
+	* @param[in,out]	lines		Lines to add line to.
+	* @param[in]		line		Line (end of line is removed).
+	******************************************************************************************************/
+	static void AddLine(std::vector<std::string>& lines, const std::string& line)
+	{
+		size_t length = line.size();
+		if (length && line[length - 1] == '\r')
+		{
+			--length;
+		}
+
+		lines.push_back(line.substr(0, length));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get time in nanoseconds.
+	* @details		Time out of range of nanoseconds (e.g. time_point::min() and max() of clock with period
+	*					coarser than 1 ns, like 100 ns of MSVC system clock) is clamped.
+	* @param[in]	time		Time point.
+	* @returns		Nanoseconds since epoch (index time).
+	******************************************************************************************************/
+	static int64_t GetTime(spdlog::log_clock::time_point time)
+	{
+		typedef spdlog::log_clock::duration Duration;
+
+		if (time.time_since_epoch() <= std::chrono::duration_cast<Duration>(std::chrono::nanoseconds::min()))
+		{
+			return std::numeric_limits<int64_t>::min();
+		}
+		if (time.time_since_epoch() >= std::chrono::duration_cast<Duration>(std::chrono::nanoseconds::max()))
+		{
+			return std::numeric_limits<int64_t>::max();
+		}
+
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Add unknown block.
+	* @details		Adds block not covered by index (any time, all levels) when it is not empty. Part longer
+	*					than maximum block length is added as more blocks.
+	* @param[out]	blocks		Blocks to add unknown block to.
+	* @param[in]	begin			Block begin (offset in log file).
+	* @param[in]	end			Block end (offset in log file).
+	******************************************************************************************************/
+	static void AddUnknownBlock(std::vector<MsvLogIndexEntry>& blocks, uint64_t begin, uint64_t end)
+	{
+		//length of entry is 32 bit -> longer part is split to more blocks (lines continue in next block)
+		while (end > begin)
+		{
+			MsvLogIndexEntry unknown;
+			unknown.firstTime = std::numeric_limits<int64_t>::min();
+			unknown.lastTime = std::numeric_limits<int64_t>::max();
+			unknown.offset = begin;
+			unknown.length = static_cast<uint32_t>(std::min<uint64_t>(end - begin, UINT32_MAX));
+			unknown.levelMask = ~0u;
+
+			blocks.push_back(unknown);
+			begin += unknown.length;
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Log file name.
+	******************************************************************************************************/
+	std::string m_logFileName;
+
+	/**************************************************************************************************//**
+	* @brief		Log file size (in bytes).
+	******************************************************************************************************/
+	uint64_t m_logFileSize;
+
+	/**************************************************************************************************//**
+	* @brief		Loaded index entries.
+	******************************************************************************************************/
+	std::vector<MsvLogIndexEntry> m_entries;
+};
+
+
+#endif // !MARSTECH_LOG_INDEX_READER_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,763 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Subscription
+* @details		Live in-process subscription to log records (lock-free broadcast ring).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			IMsvLogSubscription
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOG_SUBSCRIPTION_H
+#define MARSTECH_LOG_SUBSCRIPTION_H
+
+
+#include "mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "spdlog/sinks/sink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Log broadcast ring.
+* @details	Bounded multi-producer broadcast ring of fixed size slots. Producer claims position (atomic
+*				increment) and its slot (CAS of slot sequence to writing state), writes record and publishes
+*				it by published state of slot sequence (seqlock). Producers never wait for readers - the oldest
+*				records are overwritten. Producers never wait for each other either - when slot is still
+*				written by producer of previous lap, record is dropped (slot is marked, so readers count it as
+*				lost) and the slot is not reused until that producer finishes. Each reader has its own position and it detects overwritten records by slot
+*				sequence (it reads record again and drops it when sequence changed while it was copied).
+*				Slot data are stored in atomic words, so concurrent write and read is not a data race.
+*				Records longer than slot are truncated.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogSubscriptionSink
+* @see		MsvLogSubscription
+******************************************************************************************************/
+class MsvLogBroadcastRing
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Slot size (in bytes).
+	******************************************************************************************************/
+	static const size_t SlotSize = 512;
+
+	/**************************************************************************************************//**
+	* @brief		Number of data words in slot.
+	******************************************************************************************************/
+	static const size_t SlotWords = SlotSize / sizeof(uint64_t) - 1;
+
+	/**************************************************************************************************//**
+	* @brief		Slot state mask (slot sequence is 4 * position + state).
+	******************************************************************************************************/
+	static const uint64_t StateMask = 3;
+
+	/**************************************************************************************************//**
+	* @brief		Slot state - record is being written.
+	******************************************************************************************************/
+	static const uint64_t WritingState = 1;
+
+	/**************************************************************************************************//**
+	* @brief		Slot state - record is published.
+	******************************************************************************************************/
+	static const uint64_t PublishedState = 2;
+
+	/**************************************************************************************************//**
+	* @brief		Slot state - record was dropped while slot is still written by producer of previous lap.
+	* @details	Producer of previous lap frees the slot (state 0 of the next position) when it finishes.
+	******************************************************************************************************/
+	static const uint64_t DroppedState = 3;
+
+	/**************************************************************************************************//**
+	* @brief		Record header (stored at the beginning of slot data).
+	******************************************************************************************************/
+	struct RecordHeader
+	{
+		/**************************************************************************************************//**
+		* @brief		Time when record was logged (nanoseconds since epoch).
+		******************************************************************************************************/
+		int64_t time;
+
+		/**************************************************************************************************//**
+		* @brief		Id of thread which logged record.
+		******************************************************************************************************/
+		uint64_t threadId;
+
+		/**************************************************************************************************//**
+		* @brief		Log level.
+		******************************************************************************************************/
+		uint32_t level;
+
+		/**************************************************************************************************//**
+		* @brief		Source line (zero when it is not known).
+		******************************************************************************************************/
+		uint32_t line;
+
+		/**************************************************************************************************//**
+		* @brief		Length of logger name.
+		******************************************************************************************************/
+		uint16_t loggerLength;
+
+		/**************************************************************************************************//**
+		* @brief		Length of source file.
+		******************************************************************************************************/
+		uint16_t fileLength;
+
+		/**************************************************************************************************//**
+		* @brief		Length of source function.
+		******************************************************************************************************/
+		uint16_t functionLength;
+
+		/**************************************************************************************************//**
+		* @brief		Length of payload.
+		******************************************************************************************************/
+		uint16_t payloadLength;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Size of record data (in bytes) - logger name, source file, function and payload.
+	******************************************************************************************************/
+	static const size_t DataSize = SlotWords * sizeof(uint64_t) - sizeof(RecordHeader);
+
+	/**************************************************************************************************//**
+	* @brief			Log broadcast ring constructor.
+	* @param[in]	slotCount		Number of slots (rounded up to power of two).
+	******************************************************************************************************/
+	MsvLogBroadcastRing(size_t slotCount = 4096):
+		m_slotCount(1),
+		m_position(0)
+	{
+		while (m_slotCount < slotCount)
+		{
+			m_slotCount <<= 1;
+		}
+
+		m_spSlots.reset(new Slot[m_slotCount]);
+		for (size_t i = 0; i < m_slotCount; ++i)
+		{
+			m_spSlots[i].sequence.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	MsvLogBroadcastRing(const MsvLogBroadcastRing&) = delete;
+	MsvLogBroadcastRing& operator= (const MsvLogBroadcastRing&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Push record.
+	* @details		Writes record to the next slot. It never waits - when producer of previous lap is still
+	*					writing the same slot, record is dropped (readers count it as lost).
+	* @param[in]	msg		Logged message.
+	******************************************************************************************************/
+	void Push(const spdlog::details::log_msg& msg)
+	{
+		uint64_t words[SlotWords];
+		size_t wordCount = Serialize(msg, words);
+
+		uint64_t position = m_position.fetch_add(1, std::memory_order_relaxed);
+		Slot& slot = m_spSlots[position & (m_slotCount - 1)];
+
+		uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			if (sequence >= 4 * position + WritingState)
+			{
+				//slot was claimed by newer position (ring lapped this producer) -> record is lost anyway
+				return;
+			}
+			if ((sequence & StateMask) == WritingState || (sequence & StateMask) == DroppedState)
+			{
+				//producer of previous lap is still writing the slot -> drop record (readers see it as lost)
+				if (slot.sequence.compare_exchange_weak(sequence, 4 * position + DroppedState, std::memory_order_relaxed))
+				{
+					return;
+				}
+				continue;
+			}
+			if (slot.sequence.compare_exchange_weak(sequence, 4 * position + WritingState, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		//writing state must be visible before any data word
+		std::atomic_thread_fence(std::memory_order_release);
+		for (size_t i = 0; i < wordCount; ++i)
+		{
+			slot.words[i].store(words[i], std::memory_order_relaxed);
+		}
+
+		uint64_t written = 4 * position + WritingState;
+		if (!slot.sequence.compare_exchange_strong(written, 4 * position + PublishedState, std::memory_order_release, std::memory_order_relaxed))
+		{
+			//newer producer dropped its record while this one was written -> this record is lost, free slot
+			while ((written & StateMask) == DroppedState && !slot.sequence.compare_exchange_weak(written, written + 1, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Read record.
+	* @param[in]	position			Record position.
+	* @param[out]	pWords			Record words (@ref SlotWords words).
+	* @param[out]	overwritten		True when record was overwritten (it is lost).
+	* @retval		true				When record was read.
+	* @retval		false				When record is not published yet or it was overwritten.
+	******************************************************************************************************/
+	bool Read(uint64_t position, uint64_t* pWords, bool& overwritten) const
+	{
+		const Slot& slot = m_spSlots[position & (m_slotCount - 1)];
+
+		overwritten = false;
+		uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != 4 * position + PublishedState)
+		{
+			overwritten = sequence > 4 * position + PublishedState;
+			return false;
+		}
+
+		//header first - it says how many words are used (it is checked, record might be torn)
+		const size_t headerWords = sizeof(RecordHeader) / sizeof(uint64_t);
+		for (size_t i = 0; i < headerWords; ++i)
+		{
+			pWords[i] = slot.words[i].load(std::memory_order_relaxed);
+		}
+		size_t wordCount = std::min(GetWordCount(pWords), SlotWords);
+		for (size_t i = headerWords; i < wordCount; ++i)
+		{
+			pWords[i] = slot.words[i].load(std::memory_order_relaxed);
+		}
+
+		//record is valid only when slot was not claimed again while it was copied
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+		{
+			overwritten = true;
+			return false;
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get position of the next pushed record.
+	* @returns	Number of pushed records.
+	******************************************************************************************************/
+	uint64_t GetPosition() const
+	{
+		return m_position.load(std::memory_order_acquire);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get number of slots.
+	* @returns	Number of slots.
+	******************************************************************************************************/
+	size_t GetSlotCount() const
+	{
+		return m_slotCount;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get number of used words.
+	* @param[in]	pWords		Record words (header is in the first words).
+	* @returns		Number of words used by record.
+	******************************************************************************************************/
+	static size_t GetWordCount(const uint64_t* pWords)
+	{
+		RecordHeader header;
+		std::memcpy(&header, pWords, sizeof(header));
+
+		size_t size = sizeof(header) + header.loggerLength + header.fileLength + header.functionLength + header.payloadLength;
+		return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Serialize record.
+	* @details		Stores record header and its strings (truncated to slot size) to words.
+	* @param[in]	msg			Logged message.
+	* @param[out]	pWords		Record words (@ref SlotWords words).
+	* @returns		Number of words used by record.
+	******************************************************************************************************/
+	static size_t Serialize(const spdlog::details::log_msg& msg, uint64_t* pWords)
+	{
+		char* pData = reinterpret_cast<char*>(pWords) + sizeof(RecordHeader);
+		size_t free = DataSize;
+
+		RecordHeader header;
+		header.time = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+		header.threadId = msg.thread_id;
+		header.level = static_cast<uint32_t>(msg.level);
+		header.line = msg.source.empty() ? 0 : static_cast<uint32_t>(msg.source.line);
+		header.loggerLength = Append(pData, free, msg.logger_name.data(), msg.logger_name.size());
+		header.fileLength = Append(pData, free, msg.source.filename, msg.source.filename ? std::strlen(msg.source.filename) : 0);
+		header.functionLength = Append(pData, free, msg.source.funcname, msg.source.funcname ? std::strlen(msg.source.funcname) : 0);
+		header.payloadLength = Append(pData, free, msg.payload.data(), msg.payload.size());
+		std::memcpy(pWords, &header, sizeof(header));
+
+		return GetWordCount(pWords);
+	}
+
+	/**************************************************************************************************//**
+	* @brief				Append string.
+	* @param[in,out]	pData		Where to append (moved after appended string).
+	* @param[in,out]	free		Free space (in bytes).
+	* @param[in]		pString	String to append.
+	* @param[in]		length	String length.
+	* @returns			Number of appended bytes (string is truncated when there is not enough space).
+	******************************************************************************************************/
+	static uint16_t Append(char*& pData, size_t& free, const char* pString, size_t length)
+	{
+		length = std::min(length, free);
+		if (length)
+		{
+			std::memcpy(pData, pString, length);
+		}
+
+		pData += length;
+		free -= length;
+		return static_cast<uint16_t>(length);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Ring slot (own cache lines).
+	******************************************************************************************************/
+	struct alignas(64) Slot
+	{
+		/**************************************************************************************************//**
+		* @brief		Slot sequence (4 * position + state).
+		******************************************************************************************************/
+		std::atomic<uint64_t> sequence;
+
+		/**************************************************************************************************//**
+		* @brief		Record header followed by logger name, source file, function and payload.
+		******************************************************************************************************/
+		std::atomic<uint64_t> words[SlotWords];
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Number of slots (power of two).
+	******************************************************************************************************/
+	size_t m_slotCount;
+
+	/**************************************************************************************************//**
+	* @brief		Ring slots.
+	******************************************************************************************************/
+	std::unique_ptr<Slot[]> m_spSlots;
+
+	/**************************************************************************************************//**
+	* @brief		Position of the next pushed record (own cache line).
+	******************************************************************************************************/
+	alignas(64) std::atomic<uint64_t> m_position;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Log subscription sink.
+* @details	Sink (added to all loggers of provider) which pushes records to broadcast ring. Sink level
+*				is the lowest level of all subscriptions, it is off when there is no subscription - logger
+*				does not pass any record to sink then. Broadcast ring is created with the first subscription.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogBroadcastRing
+* @see		MsvLogSubscription
+******************************************************************************************************/
+class MsvLogSubscriptionSink:
+	public spdlog::sinks::sink
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Log subscription sink constructor.
+	* @param[in]	slotCount		Number of broadcast ring slots.
+	******************************************************************************************************/
+	MsvLogSubscriptionSink(size_t slotCount = 4096):
+		m_slotCount(slotCount),
+		m_pRing(nullptr)
+	{
+		for (size_t i = 0; i < spdlog::level::n_levels; ++i)
+		{
+			m_subscribers[i] = 0;
+		}
+
+		set_level(spdlog::level::off);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Log message.
+	* @details		Pushes message to broadcast ring.
+	* @param[in]	msg		Message to log.
+	******************************************************************************************************/
+	virtual void log(const spdlog::details::log_msg& msg) override
+	{
+		MsvLogBroadcastRing* pRing = m_pRing.load(std::memory_order_acquire);
+		if (pRing)
+		{
+			pRing->Push(msg);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Flush (nothing to flush).
+	******************************************************************************************************/
+	virtual void flush() override {  }
+
+	/**************************************************************************************************//**
+	* @brief			Set log pattern (records are not formatted).
+	* @param[in]	pattern		Log pattern.
+	******************************************************************************************************/
+	virtual void set_pattern(const std::string& pattern) override
+	{
+		(void)pattern;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log formatter (records are not formatted).
+	* @param[in]	sink_formatter		Log formatter.
+	******************************************************************************************************/
+	virtual void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+	{
+		(void)sink_formatter;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Add subscriber.
+	* @details		Creates broadcast ring (with the first subscriber) and lowers sink level when needed.
+	* @param[in]	logLevel		Minimal level of subscriber records.
+	* @returns		Broadcast ring.
+	******************************************************************************************************/
+	MsvLogBroadcastRing& AddSubscriber(MsvLogLevel logLevel)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_spRing)
+		{
+			m_spRing.reset(new MsvLogBroadcastRing(m_slotCount));
+			m_pRing.store(m_spRing.get(), std::memory_order_release);
+		}
+
+		++m_subscribers[GetLevelIndex(logLevel)];
+		UpdateLevel();
+
+		return *m_spRing;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Remove subscriber.
+	* @details		Raises sink level when it is not needed by other subscribers.
+	* @param[in]	logLevel		Minimal level of subscriber records.
+	******************************************************************************************************/
+	void RemoveSubscriber(MsvLogLevel logLevel)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		--m_subscribers[GetLevelIndex(logLevel)];
+		UpdateLevel();
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get level index.
+	* @param[in]	logLevel		Log level.
+	* @returns		Index to subscriber counts.
+	******************************************************************************************************/
+	static size_t GetLevelIndex(MsvLogLevel logLevel)
+	{
+		return std::min(static_cast<size_t>(logLevel), static_cast<size_t>(spdlog::level::n_levels - 1));
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Update sink level.
+	* @details	Sets sink level to the lowest subscriber level (off when there is no subscriber).
+	* @warning	Call it only when m_lock is locked.
+	******************************************************************************************************/
+	void UpdateLevel()
+	{
+		for (size_t i = 0; i < spdlog::level::n_levels; ++i)
+		{
+			if (m_subscribers[i])
+			{
+				set_level(static_cast<MsvLogLevel>(i));
+				return;
+			}
+		}
+
+		set_level(spdlog::level::off);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object (subscribers only, records are pushed without it).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Number of broadcast ring slots.
+	******************************************************************************************************/
+	size_t m_slotCount;
+
+	/**************************************************************************************************//**
+	* @brief		Number of subscribers by their level.
+	******************************************************************************************************/
+	size_t m_subscribers[spdlog::level::n_levels];
+
+	/**************************************************************************************************//**
+	* @brief		Broadcast ring (nullptr until the first subscription).
+	******************************************************************************************************/
+	std::unique_ptr<MsvLogBroadcastRing> m_spRing;
+
+	/**************************************************************************************************//**
+	* @brief		Broadcast ring read by logging threads.
+	******************************************************************************************************/
+	std::atomic<MsvLogBroadcastRing*> m_pRing;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Log subscription.
+* @details	Reads records from broadcast ring from its own position and returns records which match
+*				its filter. When ring overwrites records which were not read yet, they are counted as gap
+*				(returned with the next record).
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		IMsvLogSubscription
+* @see		MsvLogSubscriptionSink
+******************************************************************************************************/
+class MsvLogSubscription:
+	public IMsvLogSubscription
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Log subscription constructor.
+	* @details		Subscribes to records logged after this call.
+	* @param[in]	spSink			Subscription sink.
+	* @param[in]	loggerName		Name of logger to receive records of. Empty name means all loggers.
+	* @param[in]	logLevel			Minimal level of received records.
+	******************************************************************************************************/
+	MsvLogSubscription(std::shared_ptr<MsvLogSubscriptionSink> spSink, const std::string& loggerName, MsvLogLevel logLevel):
+		m_spSink(spSink),
+		m_ring(spSink->AddSubscriber(logLevel)),
+		m_loggerName(loggerName),
+		m_logLevel(logLevel),
+		m_position(m_ring.GetPosition()),
+		m_gap(0),
+		m_lost(0)
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Cancels subscription.
+	******************************************************************************************************/
+	virtual ~MsvLogSubscription()
+	{
+		m_spSink->RemoveSubscriber(m_logLevel);
+	}
+
+	MsvLogSubscription(const MsvLogSubscription&) = delete;
+	MsvLogSubscription& operator= (const MsvLogSubscription&) = delete;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvLogSubscription::Poll(MsvLogRecord&)
+	******************************************************************************************************/
+	virtual bool Poll(MsvLogRecord& record) override
+	{
+		uint64_t words[MsvLogBroadcastRing::SlotWords];
+
+		for (;;)
+		{
+			//slot of the next record says whether it is published - ring position (written by all
+			//producers) is read only when subscriber lags, so polling does not contend with producers
+			bool overwritten = false;
+			if (!m_ring.Read(m_position, words, overwritten))
+			{
+				if (!overwritten)
+				{
+					//record is not published yet
+					return false;
+				}
+
+				//records older than ring size are overwritten -> skip to the middle of ring (the oldest
+				//records are just being overwritten, reading them would lose next records again)
+				uint64_t ringPosition = m_ring.GetPosition();
+				if (ringPosition - m_position > m_ring.GetSlotCount())
+				{
+					m_gap += ringPosition - m_ring.GetSlotCount() / 2 - m_position;
+					m_position = ringPosition - m_ring.GetSlotCount() / 2;
+					continue;
+				}
+
+				++m_gap;
+				++m_position;
+				continue;
+			}
+			++m_position;
+
+			if (Decode(words, record))
+			{
+				record.gap = m_gap;
+				m_lost += m_gap;
+				m_gap = 0;
+				return true;
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvLogSubscription::GetLostCount() const
+	******************************************************************************************************/
+	virtual uint64_t GetLostCount() const override
+	{
+		return m_lost + m_gap;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Decode record.
+	* @details		Fills record when it matches subscription filter. Source location is taken from record
+	*					(log macros pass it). "[file:line]: " prefix added by log macros is removed from payload,
+	*					location is parsed from it only when record does not have it (logger called directly
+	*					with prefixed message).
+	* @param[in]	pWords		Record words.
+	* @param[out]	record		Decoded record.
+	* @retval		true			When record matches subscription filter.
+	* @retval		false			When record does not match subscription filter.
+	******************************************************************************************************/
+	bool Decode(const uint64_t* pWords, MsvLogRecord& record) const
+	{
+		MsvLogBroadcastRing::RecordHeader header;
+		std::memcpy(&header, pWords, sizeof(header));
+
+		const char* pData = reinterpret_cast<const char*>(pWords) + sizeof(header);
+		if (static_cast<MsvLogLevel>(header.level) < m_logLevel)
+		{
+			return false;
+		}
+		if (!m_loggerName.empty() && m_loggerName.compare(0, std::string::npos, pData, header.loggerLength) != 0)
+		{
+			return false;
+		}
+
+		record.time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(header.time)));
+		record.level = static_cast<MsvLogLevel>(header.level);
+		record.threadId = static_cast<size_t>(header.threadId);
+		record.logger.assign(pData, header.loggerLength);
+		pData += header.loggerLength;
+		record.file.assign(pData, header.fileLength);
+		pData += header.fileLength;
+		record.function.assign(pData, header.functionLength);
+		pData += header.functionLength;
+		record.line = static_cast<int>(header.line);
+
+		const char* pPayload = pData;
+		size_t payloadLength = header.payloadLength;
+		if (payloadLength && *pPayload == '[')
+		{
+			//"[file:line]: message" -> file, line and message
+			const char* pEnd = pPayload + payloadLength;
+			const char* pClose = std::search(pPayload, pEnd, "]: ", "]: " + 3);
+			const char* pColon = pClose != pEnd ? pClose : pPayload;
+			while (pColon > pPayload && *pColon != ':')
+			{
+				--pColon;
+			}
+
+			if (pColon > pPayload + 1 && pColon + 1 < pClose && std::all_of(pColon + 1, pClose, [](char c) { return c >= '0' && c <= '9'; }))
+			{
+				int line = std::atoi(std::string(pColon + 1, pClose).c_str());
+				if (record.file.empty())
+				{
+					record.file.assign(pPayload + 1, pColon);
+					record.line = line;
+				}
+
+				//prefix which does not match record location is part of message
+				if (line == record.line && record.file.compare(0, std::string::npos, pPayload + 1, static_cast<size_t>(pColon - pPayload - 1)) == 0)
+				{
+					payloadLength -= static_cast<size_t>(pClose + 3 - pPayload);
+					pPayload = pClose + 3;
+				}
+			}
+		}
+		record.payload.assign(pPayload, payloadLength);
+
+		return true;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Subscription sink (keeps broadcast ring alive).
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogSubscriptionSink> m_spSink;
+
+	/**************************************************************************************************//**
+	* @brief		Broadcast ring.
+	******************************************************************************************************/
+	const MsvLogBroadcastRing& m_ring;
+
+	/**************************************************************************************************//**
+	* @brief		Name of logger to receive records of (empty for all loggers).
+	******************************************************************************************************/
+	std::string m_loggerName;
+
+	/**************************************************************************************************//**
+	* @brief		Minimal level of received records.
+	******************************************************************************************************/
+	MsvLogLevel m_logLevel;
+
+	/**************************************************************************************************//**
+	* @brief		Position of the next read record.
+	******************************************************************************************************/
+	uint64_t m_position;
+
+	/**************************************************************************************************//**
+	* @brief		Number of records lost since the last returned record.
+	******************************************************************************************************/
+	uint64_t m_gap;
+
+	/**************************************************************************************************//**
+	* @brief		Number of records lost before the last returned record.
+	******************************************************************************************************/
+	uint64_t m_lost;
+};
+
+
+#endif // !MARSTECH_LOG_SUBSCRIPTION_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,683 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Scope Timers
+* @details		Scoped latency timers recorded to per-thread histograms and periodically reported to log.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MSV_LOG_SCOPE_TIMER
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOG_TIMER_H
+#define MARSTECH_LOG_TIMER_H
+
+
+#include "mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Latency histogram.
+* @details	Log-linear histogram of latencies (in nanoseconds). Values lower than 16 ns have their own
+*				buckets, higher values are split to 16 buckets per power of two (resolution is about 6%).
+*				Each histogram is written by one thread only (without any read-modify-write instruction)
+*				and it can be read by any thread at any time.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogTimerSite
+******************************************************************************************************/
+class MsvLogHistogram
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Number of buckets per power of two.
+	******************************************************************************************************/
+	static const size_t SubBucketCount = 16;
+
+	/**************************************************************************************************//**
+	* @brief		Number of buckets.
+	* @details	Covers values up to 2^41 ns (about 36 minutes), higher values are stored in the last bucket.
+	******************************************************************************************************/
+	static const size_t BucketCount = (41 - 3) * SubBucketCount;
+
+	/**************************************************************************************************//**
+	* @brief		Latency histogram constructor.
+	******************************************************************************************************/
+	MsvLogHistogram()
+	{
+		Clear();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Record latency.
+	* @param[in]	value		Latency (in nanoseconds).
+	* @warning		Call it from owner thread only.
+	******************************************************************************************************/
+	void Record(uint64_t value)
+	{
+		std::atomic<uint64_t>& bucket = m_buckets[GetBucket(value)];
+		bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Clear histogram.
+	* @warning		Histogram must not be used by any thread while it is cleared.
+	******************************************************************************************************/
+	void Clear()
+	{
+		for (std::atomic<uint64_t>& bucket : m_buckets)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get bucket count.
+	* @param[in]	bucket		Bucket index.
+	* @returns		Number of values recorded to bucket.
+	******************************************************************************************************/
+	uint64_t GetCount(size_t bucket) const
+	{
+		return m_buckets[bucket].load(std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get bucket index.
+	* @param[in]	value		Latency (in nanoseconds).
+	* @returns		Index of bucket for value.
+	******************************************************************************************************/
+	static size_t GetBucket(uint64_t value)
+	{
+		if (value < SubBucketCount)
+		{
+			return static_cast<size_t>(value);
+		}
+
+		size_t highestBit = GetHighestBit(value);
+		size_t bucket = (highestBit - 3) * SubBucketCount + static_cast<size_t>((value >> (highestBit - 4)) & (SubBucketCount - 1));
+
+		return bucket < BucketCount ? bucket : BucketCount - 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get bucket upper bound.
+	* @param[in]	bucket		Bucket index.
+	* @returns		The highest value stored in bucket.
+	******************************************************************************************************/
+	static uint64_t GetBucketUpperBound(size_t bucket)
+	{
+		if (bucket < SubBucketCount)
+		{
+			return bucket;
+		}
+
+		size_t shift = bucket / SubBucketCount - 1;
+		return ((static_cast<uint64_t>(SubBucketCount + bucket % SubBucketCount) + 1) << shift) - 1;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get bucket lower bound.
+	* @param[in]	bucket		Bucket index.
+	* @returns		The lowest value stored in bucket.
+	******************************************************************************************************/
+	static uint64_t GetBucketLowerBound(size_t bucket)
+	{
+		if (bucket < SubBucketCount)
+		{
+			return bucket;
+		}
+
+		size_t shift = bucket / SubBucketCount - 1;
+		return static_cast<uint64_t>(SubBucketCount + bucket % SubBucketCount) << shift;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get highest bit.
+	* @param[in]	value		Value (must not be zero).
+	* @returns		Index of the highest set bit.
+	******************************************************************************************************/
+	static size_t GetHighestBit(uint64_t value)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return static_cast<size_t>(index);
+#else
+		return static_cast<size_t>(63 - __builtin_clzll(value));
+#endif
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Histogram buckets.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_buckets[BucketCount];
+};
+
+
+class MsvLogTimerSite;
+
+
+/**************************************************************************************************//**
+* @brief		Timer registry.
+* @details	Registry of all timer sites. It is used to report all timers at once.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogTimerSite
+* @see		MsvLogTimerReporter
+******************************************************************************************************/
+class MsvLogTimerRegistry
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Get timer registry.
+	* @returns	Global timer registry.
+	******************************************************************************************************/
+	static MsvLogTimerRegistry& Get()
+	{
+		static MsvLogTimerRegistry registry;
+		return registry;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Register timer site.
+	* @param[in]	pSite		Timer site to register.
+	******************************************************************************************************/
+	void Register(MsvLogTimerSite* pSite)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_sites.push_back(pSite);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Unregister timer site.
+	* @param[in]	pSite		Timer site to unregister.
+	******************************************************************************************************/
+	void Unregister(MsvLogTimerSite* pSite)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_sites.erase(std::remove(m_sites.begin(), m_sites.end(), pSite), m_sites.end());
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Report all timers.
+	* @details	Logs one summary line per timer which has recorded anything since last report.
+	******************************************************************************************************/
+	inline void Report();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Registered timer sites.
+	******************************************************************************************************/
+	std::vector<MsvLogTimerSite*> m_sites;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Timer site.
+* @details	Timer created by one @ref MSV_LOG_SCOPE_TIMER macro. It owns histograms of all threads which
+*				have used the timer and reports their summary to its logger.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MSV_LOG_SCOPE_TIMER
+* @see		MsvLogHistogram
+******************************************************************************************************/
+class MsvLogTimerSite
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Timer site constructor.
+	* @details		Registers timer site to @ref MsvLogTimerRegistry.
+	* @param[in]	name			Timer name.
+	* @param[in]	spLogger		Logger to report timer summary to.
+	******************************************************************************************************/
+	MsvLogTimerSite(const char* name, std::shared_ptr<MsvLogger> spLogger):
+		m_name(name),
+		m_wpLogger(spLogger),
+		m_retired(MsvLogHistogram::BucketCount, 0),
+		m_reported(MsvLogHistogram::BucketCount, 0)
+	{
+		MsvLogTimerRegistry::Get().Register(this);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Timer site destructor.
+	* @details	Unregisters timer site from @ref MsvLogTimerRegistry.
+	******************************************************************************************************/
+	~MsvLogTimerSite()
+	{
+		MsvLogTimerRegistry::Get().Unregister(this);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Acquire thread histogram.
+	* @details	Returns histogram released by ended thread or creates new one. Histogram is owned by timer
+	*				site.
+	* @returns	Histogram for calling thread.
+	* @see		ReleaseThreadHistogram
+	******************************************************************************************************/
+	MsvLogHistogram* AcquireThreadHistogram()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_freeHistograms.empty())
+		{
+			MsvLogHistogram* pHistogram = m_freeHistograms.back();
+			m_freeHistograms.pop_back();
+			return pHistogram;
+		}
+
+		m_histograms.emplace_back(new MsvLogHistogram());
+		return m_histograms.back().get();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Release thread histogram.
+	* @details		Merges histogram values to retired totals (they are still reported), clears it and keeps
+	*					it for next thread.
+	* @param[in]	pHistogram		Histogram of ending thread.
+	* @warning		Histogram must not be used by its thread anymore.
+	******************************************************************************************************/
+	void ReleaseThreadHistogram(MsvLogHistogram* pHistogram)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		for (size_t bucket = 0; bucket < MsvLogHistogram::BucketCount; ++bucket)
+		{
+			m_retired[bucket] += pHistogram->GetCount(bucket);
+		}
+		pHistogram->Clear();
+
+		m_freeHistograms.push_back(pHistogram);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Report timer.
+	* @details	Sums histograms of all threads and logs values recorded since last report:
+	*				"timer <name>: count <n>, min <ns>, p50 <ns>, p99 <ns>, max <ns>".
+	*				Values are bucket bounds (min is lower bound, others are upper bounds of their buckets).
+	******************************************************************************************************/
+	void Report()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		std::vector<uint64_t> delta(MsvLogHistogram::BucketCount, 0);
+		uint64_t count = 0;
+
+		for (size_t bucket = 0; bucket < MsvLogHistogram::BucketCount; ++bucket)
+		{
+			uint64_t total = m_retired[bucket];
+			for (const std::unique_ptr<MsvLogHistogram>& spHistogram : m_histograms)
+			{
+				total += spHistogram->GetCount(bucket);
+			}
+
+			delta[bucket] = total - m_reported[bucket];
+			m_reported[bucket] = total;
+			count += delta[bucket];
+		}
+
+		std::shared_ptr<MsvLogger> spLogger = m_wpLogger.lock();
+		if (!count || !spLogger)
+		{
+			return;
+		}
+
+		size_t minBucket = 0, maxBucket = 0, p50Bucket = 0, p99Bucket = 0;
+		uint64_t p50Rank = (count + 1) / 2, p99Rank = count - count / 100, rank = 0;
+		bool first = true;
+
+		for (size_t bucket = 0; bucket < MsvLogHistogram::BucketCount; ++bucket)
+		{
+			if (!delta[bucket])
+			{
+				continue;
+			}
+
+			if (first)
+			{
+				minBucket = bucket;
+				first = false;
+			}
+			maxBucket = bucket;
+
+			if (rank < p50Rank && rank + delta[bucket] >= p50Rank)
+			{
+				p50Bucket = bucket;
+			}
+			if (rank < p99Rank && rank + delta[bucket] >= p99Rank)
+			{
+				p99Bucket = bucket;
+			}
+			rank += delta[bucket];
+		}
+
+		spLogger->info("timer {}: count {}, min {} ns, p50 {} ns, p99 {} ns, max {} ns", m_name, count,
+			MsvLogHistogram::GetBucketLowerBound(minBucket), MsvLogHistogram::GetBucketUpperBound(p50Bucket),
+			MsvLogHistogram::GetBucketUpperBound(p99Bucket), MsvLogHistogram::GetBucketUpperBound(maxBucket));
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	* @details	Synchronizes acquiring and releasing histograms and reporting.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Timer name.
+	******************************************************************************************************/
+	std::string m_name;
+
+	/**************************************************************************************************//**
+	* @brief		Logger to report to.
+	******************************************************************************************************/
+	std::weak_ptr<MsvLogger> m_wpLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Histograms of all threads (including free ones).
+	******************************************************************************************************/
+	std::vector<std::unique_ptr<MsvLogHistogram>> m_histograms;
+
+	/**************************************************************************************************//**
+	* @brief		Histograms released by ended threads (cleared, ready for reuse).
+	******************************************************************************************************/
+	std::vector<MsvLogHistogram*> m_freeHistograms;
+
+	/**************************************************************************************************//**
+	* @brief		Bucket counts of released histograms.
+	******************************************************************************************************/
+	std::vector<uint64_t> m_retired;
+
+	/**************************************************************************************************//**
+	* @brief		Bucket counts reported last time.
+	******************************************************************************************************/
+	std::vector<uint64_t> m_reported;
+};
+
+
+/**************************************************************************************************//**
+* @copydoc MsvLogTimerRegistry::Report()
+******************************************************************************************************/
+inline void MsvLogTimerRegistry::Report()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (MsvLogTimerSite* pSite : m_sites)
+	{
+		pSite->Report();
+	}
+}
+
+
+/**************************************************************************************************//**
+* @brief		Thread histogram of timer site.
+* @details	Thread local holder of histogram. It acquires histogram for its thread and releases it (values
+*				are merged to retired totals of timer site) when thread ends.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MSV_LOG_SCOPE_TIMER
+******************************************************************************************************/
+class MsvLogThreadHistogram
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Thread histogram constructor.
+	* @param[in]	site		Timer site.
+	******************************************************************************************************/
+	MsvLogThreadHistogram(MsvLogTimerSite& site):
+		m_site(site),
+		m_pHistogram(site.AcquireThreadHistogram())
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Thread histogram destructor.
+	* @details	Releases histogram to timer site.
+	******************************************************************************************************/
+	~MsvLogThreadHistogram()
+	{
+		m_site.ReleaseThreadHistogram(m_pHistogram);
+	}
+
+	MsvLogThreadHistogram(const MsvLogThreadHistogram&) = delete;
+	MsvLogThreadHistogram& operator= (const MsvLogThreadHistogram&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief		Get histogram.
+	* @returns	Histogram of calling thread.
+	******************************************************************************************************/
+	MsvLogHistogram* Get() const
+	{
+		return m_pHistogram;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Timer site.
+	******************************************************************************************************/
+	MsvLogTimerSite& m_site;
+
+	/**************************************************************************************************//**
+	* @brief		Histogram of thread.
+	******************************************************************************************************/
+	MsvLogHistogram* m_pHistogram;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Scope timer.
+* @details	Takes timestamp in constructor and records elapsed time to histogram in destructor.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MSV_LOG_SCOPE_TIMER
+******************************************************************************************************/
+class MsvLogScopeTimer
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Scope timer constructor.
+	* @param[in]	pHistogram		Histogram of calling thread.
+	******************************************************************************************************/
+	MsvLogScopeTimer(MsvLogHistogram* pHistogram):
+		m_pHistogram(pHistogram),
+		m_start(std::chrono::steady_clock::now())
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Scope timer destructor.
+	* @details	Records elapsed time to histogram.
+	******************************************************************************************************/
+	~MsvLogScopeTimer()
+	{
+		m_pHistogram->Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count()));
+	}
+
+	MsvLogScopeTimer(const MsvLogScopeTimer&) = delete;
+	MsvLogScopeTimer& operator= (const MsvLogScopeTimer&) = delete;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Histogram of calling thread.
+	******************************************************************************************************/
+	MsvLogHistogram* m_pHistogram;
+
+	/**************************************************************************************************//**
+	* @brief		Start timestamp.
+	******************************************************************************************************/
+	std::chrono::steady_clock::time_point m_start;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Timer reporter.
+* @details	Runs thread which reports all timers (@ref MsvLogTimerRegistry::Report) once per interval.
+*				Timers are reported for the last time when reporter is destroyed.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogTimerRegistry
+******************************************************************************************************/
+class MsvLogTimerReporter
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Timer reporter constructor.
+	* @details		Starts reporting thread.
+	* @param[in]	interval		Report interval.
+	******************************************************************************************************/
+	MsvLogTimerReporter(std::chrono::milliseconds interval = std::chrono::seconds(60)):
+		m_interval(interval),
+		m_stop(false)
+	{
+		m_thread = std::thread([this]()
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			while (!m_condition.wait_for(lock, m_interval, [this]() { return m_stop; }))
+			{
+				MsvLogTimerRegistry::Get().Report();
+			}
+		});
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Timer reporter destructor.
+	* @details	Stops reporting thread and reports all timers for the last time.
+	******************************************************************************************************/
+	~MsvLogTimerReporter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+
+		MsvLogTimerRegistry::Get().Report();
+	}
+
+	MsvLogTimerReporter(const MsvLogTimerReporter&) = delete;
+	MsvLogTimerReporter& operator= (const MsvLogTimerReporter&) = delete;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Report interval.
+	******************************************************************************************************/
+	std::chrono::milliseconds m_interval;
+
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Stop condition.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Stop flag.
+	******************************************************************************************************/
+	bool m_stop;
+
+	/**************************************************************************************************//**
+	* @brief		Reporting thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+};
+
+
+/**************************************************************************************************//**
+* @def			MSV_CONCAT
+* @brief			Concatenation macro.
+* @see			MSV_CONCAT_
+******************************************************************************************************/
+#define MSV_CONCAT(first, second) MSV_CONCAT_(first, second)
+
+/**************************************************************************************************//**
+* @def			MSV_CONCAT_
+* @brief			Concatenation macro.
+* @see			MSV_CONCAT
+******************************************************************************************************/
+#define MSV_CONCAT_(first, second) first##second
+
+
+#ifdef MSV_LOG_DISABLE_TIMERS
+
+#define MSV_LOG_SCOPE_TIMER(msvLogger, msvTimerName)
+
+#else
+
+/**************************************************************************************************//**
+* @def			MSV_LOG_SCOPE_TIMER(msvLogger, msvTimerName)
+* @brief			Scope timer.
+* @details		Measures time from this macro to the end of current scope and records it to histogram of
+*					calling thread (no lock, no read-modify-write instruction). Histogram of ended thread is
+*					merged to timer site and reused by next thread. Summary line (count, min, p50,
+*					p99 and max) is logged to msvLogger by @ref MsvLogTimerRegistry::Report (see
+*					@ref MsvLogTimerReporter for periodic reports).
+* @param[in]	msvLogger		Logger to report to (logger used by the first call is used).
+* @param[in]	msvTimerName	Timer name.
+* @note			Define MSV_LOG_DISABLE_TIMERS to compile all scope timers out.
+******************************************************************************************************/
+#define MSV_LOG_SCOPE_TIMER(msvLogger, msvTimerName) \
+	static MsvLogTimerSite MSV_CONCAT(msvTimerSite, __LINE__)(msvTimerName, msvLogger); \
+	static thread_local MsvLogThreadHistogram MSV_CONCAT(msvTimerHistogram, __LINE__)(MSV_CONCAT(msvTimerSite, __LINE__)); \
+	MsvLogScopeTimer MSV_CONCAT(msvScopeTimer, __LINE__)(MSV_CONCAT(msvTimerHistogram, __LINE__).Get())
+
+#endif // MSV_LOG_DISABLE_TIMERS
+
+
+#endif // !MARSTECH_LOG_TIMER_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,657 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Configuration
+* @details		Hot-reloadable logging configuration (levels, patterns, sink parameters and flush policy).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvLoggerProvider::WatchConfig
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_LOGGING_CONFIG_H
+#define MARSTECH_LOGGING_CONFIG_H
+
+
+#include "mlogging.h"
+#include "MsvAtomicSnapshot.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "spdlog/formatter.h"
+#include "spdlog/pattern_formatter.h"
+
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Logging configuration.
+* @details	Immutable snapshot of logging configuration. It is parsed from text file with lines
+*				"key = value" (empty lines and lines starting with '#' are ignored):
+*				- level = info						default log level
+*				- pattern = [%n] [%l] %v		default log pattern
+*				- flush_level = err				flush log files on this (and higher) level
+*				- max_log_file_size = 10485760	maximum size of one log file (new log files only, it is not
+*														changed when key is not present)
+*				- max_log_files = 3				maximum number of log files (new log files only, it is not
+*														changed when key is not present)
+*				- logger.<name>.level = debug	log level of logger <name>
+*				- logger.<name>.pattern = %v	log pattern of logger <name>
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLoggerProvider::ApplyConfig
+******************************************************************************************************/
+struct MsvLoggingConfig
+{
+	/**************************************************************************************************//**
+	* @brief		Logger configuration.
+	******************************************************************************************************/
+	struct Logger
+	{
+		/**************************************************************************************************//**
+		* @brief		Logger configuration constructor.
+		******************************************************************************************************/
+		Logger():
+			hasLevel(false),
+			level(spdlog::level::info),
+			patternIndex(0)
+		{
+		}
+
+		/**************************************************************************************************//**
+		* @brief		True when logger has its own level.
+		******************************************************************************************************/
+		bool hasLevel;
+
+		/**************************************************************************************************//**
+		* @brief		Logger level (valid when hasLevel is true).
+		******************************************************************************************************/
+		MsvLogLevel level;
+
+		/**************************************************************************************************//**
+		* @brief		Index of logger pattern in patterns (0 is default pattern).
+		******************************************************************************************************/
+		size_t patternIndex;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Logging configuration constructor.
+	* @details	Sets defaults (same as @ref MsvLoggerProvider defaults).
+	******************************************************************************************************/
+	MsvLoggingConfig():
+		version(0),
+		level(spdlog::level::info),
+		flushLevel(spdlog::level::err),
+		maxLogFileSize(10485760),
+		maxLogFiles(3),
+		hasMaxLogFileSize(false),
+		hasMaxLogFiles(false)
+	{
+		//[2014-31-10 23:46:59.256789123] [processId] [threadId] [loggerName] [severity] "message"
+		patterns.push_back("[%Y-%m-%d %H:%M:%S.%F] [%P] [%t] [%n] [%l] %v");
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Parse configuration.
+	* @param[in]	text			Configuration text.
+	* @param[out]	config		Parsed configuration.
+	* @retval		true			When whole text was parsed.
+	* @retval		false			When some line is not valid (config is not changed).
+	******************************************************************************************************/
+	static bool Parse(const std::string& text, MsvLoggingConfig& config)
+	{
+		MsvLoggingConfig parsed;
+		std::istringstream stream(text);
+		std::string line;
+
+		while (std::getline(stream, line))
+		{
+			line = Trim(line);
+			if (line.empty() || line[0] == '#')
+			{
+				continue;
+			}
+
+			size_t separator = line.find('=');
+			if (separator == std::string::npos)
+			{
+				return false;
+			}
+
+			std::string key = Trim(line.substr(0, separator));
+			std::string value = Trim(line.substr(separator + 1));
+
+			if (key == "level")
+			{
+				if (!ParseLevel(value, parsed.level))
+				{
+					return false;
+				}
+			}
+			else if (key == "pattern")
+			{
+				parsed.patterns[0] = value;
+			}
+			else if (key == "flush_level")
+			{
+				if (!ParseLevel(value, parsed.flushLevel))
+				{
+					return false;
+				}
+			}
+			else if (key == "max_log_file_size")
+			{
+				if (!ParseNumber(value, parsed.maxLogFileSize) || parsed.maxLogFileSize <= 0)
+				{
+					return false;
+				}
+				parsed.hasMaxLogFileSize = true;
+			}
+			else if (key == "max_log_files")
+			{
+				if (!ParseNumber(value, parsed.maxLogFiles))
+				{
+					return false;
+				}
+				parsed.hasMaxLogFiles = true;
+			}
+			else if (key.compare(0, 7, "logger.") == 0 && key.rfind('.') > 7)
+			{
+				size_t dot = key.rfind('.');
+				Logger& logger = parsed.loggers[key.substr(7, dot - 7)];
+				std::string property = key.substr(dot + 1);
+
+				if (property == "level")
+				{
+					if (!ParseLevel(value, logger.level))
+					{
+						return false;
+					}
+					logger.hasLevel = true;
+				}
+				else if (property == "pattern")
+				{
+					logger.patternIndex = parsed.patterns.size();
+					parsed.patterns.push_back(value);
+				}
+				else
+				{
+					return false;
+				}
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		config = parsed;
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get logger level.
+	* @param[in]	loggerName		Logger name.
+	* @returns		Level of logger (or default level).
+	******************************************************************************************************/
+	MsvLogLevel GetLevel(spdlog::string_view_t loggerName) const
+	{
+		std::map<std::string, Logger, std::less<>>::const_iterator it = loggers.find(loggerName);
+		return it != loggers.end() && it->second.hasLevel ? it->second.level : level;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get logger pattern index.
+	* @param[in]	loggerName		Logger name.
+	* @returns		Index of logger pattern in patterns (or 0 for default pattern).
+	******************************************************************************************************/
+	size_t GetPatternIndex(spdlog::string_view_t loggerName) const
+	{
+		std::map<std::string, Logger, std::less<>>::const_iterator it = loggers.find(loggerName);
+		return it != loggers.end() ? it->second.patternIndex : 0;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Configuration version.
+	* @details	Set when configuration is published (each published configuration has unique version).
+	******************************************************************************************************/
+	uint64_t version;
+
+	/**************************************************************************************************//**
+	* @brief		Default log level.
+	******************************************************************************************************/
+	MsvLogLevel level;
+
+	/**************************************************************************************************//**
+	* @brief		Flush level.
+	******************************************************************************************************/
+	MsvLogLevel flushLevel;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum size of one log file (in bytes).
+	******************************************************************************************************/
+	int maxLogFileSize;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum number of log files.
+	******************************************************************************************************/
+	int maxLogFiles;
+
+	/**************************************************************************************************//**
+	* @brief		True when maximum size of one log file was set by configuration.
+	******************************************************************************************************/
+	bool hasMaxLogFileSize;
+
+	/**************************************************************************************************//**
+	* @brief		True when maximum number of log files was set by configuration.
+	******************************************************************************************************/
+	bool hasMaxLogFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Log patterns (the first one is default pattern).
+	******************************************************************************************************/
+	std::vector<std::string> patterns;
+
+	/**************************************************************************************************//**
+	* @brief		Configuration of loggers (by logger name, it can be found by string view without copy).
+	******************************************************************************************************/
+	std::map<std::string, Logger, std::less<>> loggers;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Trim string.
+	* @param[in]	value		String to trim.
+	* @returns		String without leading and trailing white spaces.
+	******************************************************************************************************/
+	static std::string Trim(const std::string& value)
+	{
+		size_t begin = value.find_first_not_of(" \t\r\n");
+		if (begin == std::string::npos)
+		{
+			return std::string();
+		}
+
+		return value.substr(begin, value.find_last_not_of(" \t\r\n") - begin + 1);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Parse log level.
+	* @param[in]	value		Level name (trace, debug, info, warning, error, critical, off).
+	* @param[out]	level		Parsed level.
+	* @retval		true		When level is valid.
+	* @retval		false		When level is not valid.
+	******************************************************************************************************/
+	static bool ParseLevel(const std::string& value, MsvLogLevel& level)
+	{
+		level = spdlog::level::from_str(value);
+
+		//from_str returns off for unknown names
+		return level != spdlog::level::off || value == "off";
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Parse number.
+	* @param[in]	value		Decimal number (without sign and units).
+	* @param[out]	number	Parsed number.
+	* @retval		true		When whole value is valid number.
+	* @retval		false		When value is not number, it has some suffix (e.g. "10MB") or it is too big.
+	******************************************************************************************************/
+	static bool ParseNumber(const std::string& value, int& number)
+	{
+		if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0])))
+		{
+			return false;
+		}
+
+		errno = 0;
+		char* pEnd = nullptr;
+		unsigned long long parsed = std::strtoull(value.c_str(), &pEnd, 10);
+		if (errno == ERANGE || *pEnd != '\0' || parsed > static_cast<unsigned long long>(INT_MAX))
+		{
+			return false;
+		}
+
+		number = static_cast<int>(parsed);
+		return true;
+	}
+};
+
+
+/**************************************************************************************************//**
+* @brief		Configuration formatter.
+* @details	Formatter which formats each record by pattern of its logger in current (published)
+*				configuration. Configuration is read without any lock - logging threads are never blocked
+*				by configuration reload. Pattern formatters are created when new configuration is used
+*				for the first time (formatter is used under sink lock, so its cache does not need any lock).
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLoggingConfig
+* @see		MsvAtomicSnapshot
+******************************************************************************************************/
+class MsvConfigFormatter:
+	public spdlog::formatter
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Configuration formatter constructor.
+	* @param[in]	spConfig		Published configuration.
+	******************************************************************************************************/
+	MsvConfigFormatter(std::shared_ptr<MsvAtomicSnapshot<MsvLoggingConfig>> spConfig):
+		m_spConfig(spConfig),
+		m_version(0)
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvConfigFormatter() {  }
+
+	/**************************************************************************************************//**
+	* @brief			Format message.
+	* @param[in]	msg		Message to format.
+	* @param[out]	dest		Formatted message.
+	******************************************************************************************************/
+	virtual void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override
+	{
+		MsvAtomicSnapshot<MsvLoggingConfig>::Guard config(*m_spConfig);
+
+		if (config->version != m_version)
+		{
+			m_formatters.clear();
+			m_formatters.resize(config->patterns.size());
+			m_version = config->version;
+		}
+
+		size_t patternIndex = config->loggers.empty() ? 0 : config->GetPatternIndex(msg.logger_name);
+		if (!m_formatters[patternIndex])
+		{
+			m_formatters[patternIndex].reset(new spdlog::pattern_formatter(config->patterns[patternIndex]));
+		}
+
+		m_formatters[patternIndex]->format(msg, dest);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Clone formatter.
+	* @returns	New formatter using the same configuration.
+	******************************************************************************************************/
+	virtual std::unique_ptr<spdlog::formatter> clone() const override
+	{
+		return std::unique_ptr<spdlog::formatter>(new MsvConfigFormatter(m_spConfig));
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Published configuration.
+	******************************************************************************************************/
+	std::shared_ptr<MsvAtomicSnapshot<MsvLoggingConfig>> m_spConfig;
+
+	/**************************************************************************************************//**
+	* @brief		Version of configuration used by pattern formatters.
+	******************************************************************************************************/
+	uint64_t m_version;
+
+	/**************************************************************************************************//**
+	* @brief		Pattern formatters (by pattern index).
+	******************************************************************************************************/
+	std::vector<std::unique_ptr<spdlog::formatter>> m_formatters;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Configuration file watcher.
+* @details	Watches configuration file and calls callback with its content when it changes (and once
+*				when watcher starts). On Linux, it uses inotify on folder of configuration file (so it works
+*				even when editor replaces the file). On other systems, it polls file content.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLoggerProvider::WatchConfig
+******************************************************************************************************/
+class MsvConfigFileWatcher
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Configuration changed callback type.
+	* @details		Called with content of configuration file (only with non-empty valid configuration).
+	******************************************************************************************************/
+	typedef std::function<void(const std::string&)> ConfigChanged;
+
+	/**************************************************************************************************//**
+	* @brief			Configuration file watcher constructor.
+	* @details		Starts watching thread.
+	* @param[in]	configFile		Configuration file name (path).
+	* @param[in]	configChanged	Configuration changed callback.
+	* @param[in]	pollInterval	Poll interval (stop check interval with inotify).
+	******************************************************************************************************/
+	MsvConfigFileWatcher(const std::string& configFile, ConfigChanged configChanged, std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000)):
+		m_configFile(configFile),
+		m_configChanged(configChanged),
+		m_pollInterval(pollInterval),
+		m_stop(false)
+	{
+		m_thread = std::thread([this]() { Watch(); });
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Configuration file watcher destructor.
+	* @details	Stops watching thread.
+	******************************************************************************************************/
+	~MsvConfigFileWatcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	MsvConfigFileWatcher(const MsvConfigFileWatcher&) = delete;
+	MsvConfigFileWatcher& operator= (const MsvConfigFileWatcher&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Read file.
+	* @param[in]	fileName		File name (path).
+	* @param[out]	content		File content.
+	* @retval		true			When file was read.
+	* @retval		false			When file can not be opened.
+	******************************************************************************************************/
+	static bool ReadFile(const std::string& fileName, std::string& content)
+	{
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file.good())
+		{
+			return false;
+		}
+
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		content = stream.str();
+
+		return true;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Watch configuration file.
+	* @details	Watching thread main function.
+	******************************************************************************************************/
+	void Watch()
+	{
+		std::string lastContent;
+		CheckFile(lastContent);
+
+#ifdef __linux__
+		int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotifyFd >= 0)
+		{
+			size_t slash = m_configFile.rfind('/');
+			std::string folder = slash == std::string::npos ? std::string(".") : m_configFile.substr(0, slash + 1);
+			std::string fileName = slash == std::string::npos ? m_configFile : m_configFile.substr(slash + 1);
+
+			//only finished writes (and renames) of configuration file are checked, file which is just being
+			//written (e.g. truncated) must not be read
+			if (inotify_add_watch(inotifyFd, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0)
+			{
+				pollfd pollFd = { inotifyFd, POLLIN, 0 };
+				while (!IsStopped())
+				{
+					if (poll(&pollFd, 1, static_cast<int>(m_pollInterval.count())) > 0)
+					{
+						bool changed = false;
+						alignas(inotify_event) char events[4096];
+						ssize_t length;
+						while ((length = read(inotifyFd, events, sizeof(events))) > 0)
+						{
+							for (ssize_t offset = 0; offset < length;)
+							{
+								const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(events + offset);
+								//name is padded by zeros, queue overflow loses names -> check file anyway
+								changed |= (pEvent->mask & IN_Q_OVERFLOW) || (pEvent->len > 0 && fileName == pEvent->name);
+								offset += static_cast<ssize_t>(sizeof(inotify_event) + pEvent->len);
+							}
+						}
+
+						if (changed)
+						{
+							CheckFile(lastContent);
+						}
+					}
+				}
+
+				close(inotifyFd);
+				return;
+			}
+
+			close(inotifyFd);
+		}
+#endif
+
+		//polling fallback
+		std::unique_lock<std::mutex> lock(m_lock);
+		while (!m_condition.wait_for(lock, m_pollInterval, [this]() { return m_stop; }))
+		{
+			lock.unlock();
+			CheckFile(lastContent);
+			lock.lock();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief				Check configuration file.
+	* @details			Calls callback when content of configuration file changed. Empty content and content
+	*						which is not valid configuration (e.g. file is being replaced) are ignored.
+	* @param[in,out]	lastContent		Last content of configuration file.
+	******************************************************************************************************/
+	void CheckFile(std::string& lastContent)
+	{
+		std::string content;
+		if (!ReadFile(m_configFile, content) || content.empty() || content == lastContent)
+		{
+			return;
+		}
+
+		lastContent = content;
+		MsvLoggingConfig config;
+		if (MsvLoggingConfig::Parse(content, config))
+		{
+			m_configChanged(content);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Check stop flag.
+	* @retval	true		When watcher is being stopped.
+	* @retval	false		When watcher is running.
+	******************************************************************************************************/
+	bool IsStopped()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_stop;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Configuration file name (path).
+	******************************************************************************************************/
+	std::string m_configFile;
+
+	/**************************************************************************************************//**
+	* @brief		Configuration changed callback.
+	******************************************************************************************************/
+	ConfigChanged m_configChanged;
+
+	/**************************************************************************************************//**
+	* @brief		Poll interval.
+	******************************************************************************************************/
+	std::chrono::milliseconds m_pollInterval;
+
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Stop condition.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Stop flag.
+	******************************************************************************************************/
+	bool m_stop;
+
+	/**************************************************************************************************//**
+	* @brief		Watching thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+};
+
+
+#endif // !MARSTECH_LOGGING_CONFIG_H
+
+/** @} */	//End of group MLOGGING.
@@ -0,0 +1,977 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Rotating File Sink
+* @details		Rotating file sink with optional sparse time/level index written alongside log files.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @see			MsvLoggerProvider
+* @see			MsvLogIndexReader
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_ROTATING_FILE_SINK_H
+#define MARSTECH_ROTATING_FILE_SINK_H
+
+
+#include "mlogging.h"
+#include "MsvLogFilePool.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "spdlog/sinks/sink.h"
+#include "spdlog/details/os.h"
+#include "spdlog/details/file_helper.h"
+#include "spdlog/pattern_formatter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Log index entry.
+* @details	One entry of sparse log index (sidecar file "<log file>.idx"). Each entry describes one
+*				block of log file - its position, time range and levels of all records in the block.
+*				Entries are stored in binary form (native endianness) in order of their offsets.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvRotatingFileSink
+* @see		MsvLogIndexReader
+******************************************************************************************************/
+struct MsvLogIndexEntry
+{
+	/**************************************************************************************************//**
+	* @brief		Time of the first record in block (nanoseconds since epoch).
+	******************************************************************************************************/
+	int64_t firstTime;
+
+	/**************************************************************************************************//**
+	* @brief		Time of the last record in block (nanoseconds since epoch).
+	******************************************************************************************************/
+	int64_t lastTime;
+
+	/**************************************************************************************************//**
+	* @brief		Offset of block in log file (in bytes).
+	******************************************************************************************************/
+	uint64_t offset;
+
+	/**************************************************************************************************//**
+	* @brief		Length of block (in bytes, longer parts of log file are described by more entries).
+	******************************************************************************************************/
+	uint32_t length;
+
+	/**************************************************************************************************//**
+	* @brief		Level mask of records in block (bit 1 << level is set for every level present).
+	******************************************************************************************************/
+	uint32_t levelMask;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Rotating file sink.
+* @details	Multithreaded rotating file sink (same rotation as spdlog rotating_file_sink). When index
+*				block size is not zero, it also writes sparse index to sidecar file "<log file>.idx" for
+*				each log file. Index entry is written once per block (when block reaches index block size),
+*				so index costs just few comparisons per record and one unbuffered write (of one entry) per
+*				block.
+*				In durable mode, flush (spdlog flushes sink after records with flush level - error by
+*				default) returns after flushed records are on disk. Concurrent flushes are grouped - one
+*				thread (leader) syncs everything written so far and releases all waiting threads.
+*				When log file pool is set, log file can be closed by the pool (to limit number of opened
+*				files) and it is opened again with the next record.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvLogIndexEntry
+* @see		MsvLogIndexReader
+******************************************************************************************************/
+class MsvRotatingFileSink:
+	public spdlog::sinks::sink,
+	public IMsvPooledLogFile
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Size of write buffer (in bytes) - buffered records are written when it is full or flushed.
+	******************************************************************************************************/
+	static const size_t WriteBufferSize = 8192;
+
+	/**************************************************************************************************//**
+	* @brief			Rotating file sink constructor.
+	* @param[in]	baseFileName		Log file name (path) - the newest log file.
+	* @param[in]	maxLogFileSize		Maximum size of one log file (in bytes).
+	* @param[in]	maxLogFiles			Maximum number of log files (rotating logger, oldest file will be deleted).
+	* @param[in]	indexBlockSize		Size of indexed block (in bytes). Zero means no index.
+	* @throws		spdlog::spdlog_ex	When log file (or index file) can not be opened.
+	******************************************************************************************************/
+	MsvRotatingFileSink(const std::string& baseFileName, size_t maxLogFileSize, size_t maxLogFiles, size_t indexBlockSize = 0):
+		m_baseFileName(baseFileName),
+		m_maxLogFileSize(maxLogFileSize),
+		m_maxLogFiles(maxLogFiles),
+		m_indexBlockSize(indexBlockSize),
+		m_fd(-1),
+		m_indexFd(-1),
+		m_currentSize(0),
+		m_fileSize(0),
+		m_positionalWrites(false),
+		m_durable(false),
+		m_preallocateSize(0),
+		m_preallocatedSize(0),
+		m_writeSequence(0),
+		m_syncedSequence(0),
+		m_syncing(false),
+		m_referenced(false),
+		m_spFormatter(new spdlog::pattern_formatter())
+	{
+		if (m_maxLogFileSize == 0)
+		{
+			throw spdlog::spdlog_ex("MsvRotatingFileSink: max log file size can not be zero");
+		}
+
+		ResetBlock();
+		OpenFiles(false);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Closes current index block and all opened files.
+	******************************************************************************************************/
+	virtual ~MsvRotatingFileSink()
+	{
+		//pool must not close log file while it is being destroyed
+		if (m_spFilePool)
+		{
+			m_spFilePool->Closed(this);
+		}
+
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		CloseFiles();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Log message.
+	* @details		Formats message, rotates log files when needed and writes message to log file.
+	* @param[in]	msg		Message to log.
+	******************************************************************************************************/
+	virtual void log(const spdlog::details::log_msg& msg) override
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (m_fd < 0)
+		{
+			//log file was closed by pool (or previous rotation failed) -> open it again
+			OpenFiles(false);
+			if (m_spFilePool)
+			{
+				m_spFilePool->Opened(this);
+			}
+		}
+		if (m_spFilePool)
+		{
+			m_referenced.store(true, std::memory_order_relaxed);
+		}
+
+		spdlog::memory_buf_t formatted;
+		m_spFormatter->format(msg, formatted);
+
+		if (m_currentSize + formatted.size() > m_maxLogFileSize && m_currentSize > 0)
+		{
+			Rotate();
+		}
+
+		if (m_currentSize + formatted.size() > m_preallocatedSize)
+		{
+			Preallocate(formatted.size());
+		}
+
+		m_buffer.append(formatted.data(), formatted.data() + formatted.size());
+		if (m_buffer.size() >= WriteBufferSize)
+		{
+			FlushFiles();
+		}
+
+		if (m_indexFd >= 0)
+		{
+			UpdateBlock(msg, formatted.size());
+		}
+
+		m_currentSize += formatted.size();
+		++m_writeSequence;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Flush log file (and index file).
+	* @details	In durable mode, it also syncs log file (see @ref Sync).
+	* @throws	spdlog::spdlog_ex	When log file can not be synced.
+	******************************************************************************************************/
+	virtual void flush() override
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		FlushFiles();
+
+		if (m_durable)
+		{
+			SyncFile(lock);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Sync log file.
+	* @details	Returns when all records written so far are on disk (fdatasync). Concurrent calls are grouped
+	*				- only one sync runs at a time and it covers records of all waiting threads.
+	* @throws	spdlog::spdlog_ex	When log file can not be synced.
+	******************************************************************************************************/
+	void Sync()
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+
+		FlushFiles();
+		SyncFile(lock);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set durability.
+	* @param[in]	durable				True when flush should sync log file to disk (see @ref Sync).
+	* @param[in]	preallocateSize	Size of log file chunk preallocated (on Linux, by fallocate) ahead of
+	*											written records. File size is extended with the chunk, so sync of
+	*											records written to it does not update file size (metadata). Zero
+	*											turns preallocation off.
+	* @note			While log file is opened, it ends with zeros of preallocated chunk. They are removed when it
+	*					is closed (or rotated) and when it is opened again after crash.
+	******************************************************************************************************/
+	void SetDurability(bool durable, size_t preallocateSize = 0)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_durable = durable;
+		m_preallocateSize = preallocateSize;
+		if (m_preallocateSize && m_fd >= 0 && !m_buffer.size())
+		{
+			TrimPreallocatedTail();
+		}
+		m_preallocatedSize = m_currentSize;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log file pool.
+	* @details		Adds opened log file to pool (it might close another log file in the pool).
+	* @param[in]	spFilePool		Log file pool (shared by sinks).
+	* @warning		Call it just once, before the first record is logged.
+	******************************************************************************************************/
+	void SetFilePool(std::shared_ptr<MsvLogFilePool> spFilePool)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_spFilePool = spFilePool;
+		if (m_spFilePool && m_fd >= 0)
+		{
+			m_spFilePool->Opened(this);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPooledLogFile::TakeReferenced()
+	******************************************************************************************************/
+	virtual bool TakeReferenced() override
+	{
+		return m_referenced.load(std::memory_order_relaxed) && m_referenced.exchange(false, std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPooledLogFile::TryCloseFile()
+	******************************************************************************************************/
+	virtual bool TryCloseFile() override
+	{
+		std::unique_lock<std::mutex> lock(m_lock, std::try_to_lock);
+		if (!lock)
+		{
+			return false;
+		}
+
+		//pool lock (and lock of opening log file) is held -> do not sync, it is synced later by new descriptor when needed
+		CloseFiles(false);
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log pattern.
+	* @param[in]	pattern		Log pattern.
+	******************************************************************************************************/
+	virtual void set_pattern(const std::string& pattern) override
+	{
+		set_formatter(std::unique_ptr<spdlog::formatter>(new spdlog::pattern_formatter(pattern)));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log formatter.
+	* @param[in]	sink_formatter		Log formatter.
+	******************************************************************************************************/
+	virtual void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_spFormatter = std::move(sink_formatter);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Calculate log file name.
+	* @details		Calculates log file name by its index - same as spdlog rotating file sink.
+	*					("logs/mylog.txt", 3) => "logs/mylog.3.txt".
+	* @param[in]	baseFileName	Log file name (path) - the newest log file.
+	* @param[in]	index				Index of log file.
+	* @returns		Log file name with index.
+	******************************************************************************************************/
+	static std::string CalcFileName(const std::string& baseFileName, size_t index)
+	{
+		if (index == 0)
+		{
+			return baseFileName;
+		}
+
+		std::string basename, ext;
+		std::tie(basename, ext) = spdlog::details::file_helper::split_by_extension(baseFileName);
+		return basename + "." + std::to_string(index) + ext;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Calculate index file name.
+	* @param[in]	logFileName		Log file name (path).
+	* @returns		Index file name ("<log file>.idx").
+	******************************************************************************************************/
+	static std::string CalcIndexFileName(const std::string& logFileName)
+	{
+		return logFileName + ".idx";
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Open log file (and index file).
+	* @param[in]	truncate		True when files should be truncated, false to append.
+	* @throws		spdlog::spdlog_ex	When file can not be opened.
+	******************************************************************************************************/
+	void OpenFiles(bool truncate)
+	{
+		m_fileName = CalcFileName(m_baseFileName, 0);
+
+		m_fd = OpenFd(m_fileName, truncate);
+		if (m_fd < 0)
+		{
+			throw spdlog::spdlog_ex("MsvRotatingFileSink: failed opening file " + m_fileName, errno);
+		}
+		m_currentSize = GetFdSize(m_fd);
+		m_fileSize = m_currentSize;
+		m_positionalWrites = false;
+		if (m_preallocateSize && !truncate)
+		{
+			TrimPreallocatedTail();
+		}
+		m_preallocatedSize = m_currentSize;
+
+		if (m_indexBlockSize)
+		{
+			m_indexFd = OpenFd(CalcIndexFileName(m_fileName), truncate);
+			if (m_indexFd < 0)
+			{
+				throw spdlog::spdlog_ex("MsvRotatingFileSink: failed opening file " + CalcIndexFileName(m_fileName), errno);
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Close log file (and index file).
+	* @details	Writes buffered records and current index block before closing. Write errors are ignored
+	*				(it is called from destructor).
+	* @param[in]	sync		False when durable log file should not be synced (records are synced later by
+	*								@ref SyncFile then).
+	******************************************************************************************************/
+	void CloseFiles(bool sync = true)
+	{
+		if (m_indexFd >= 0)
+		{
+			WriteBlock();
+			CloseFd(m_indexFd);
+			m_indexFd = -1;
+		}
+
+		if (m_fd >= 0)
+		{
+			WriteBuffer();
+
+#ifdef __linux__
+			if (m_positionalWrites)
+			{
+				//remove preallocated chunk beyond written records
+				if (ftruncate(m_fd, static_cast<off_t>(m_fileSize))) {  }
+			}
+#endif
+
+			if (m_durable && sync)
+			{
+				//records of closed (rotated) file would not be synced later
+				if (SyncFd(m_fd) == 0)
+				{
+					m_syncedSequence = m_writeSequence;
+				}
+			}
+
+			CloseFd(m_fd);
+			m_fd = -1;
+
+			//closed (e.g. pooled) log file does not hold write buffer memory
+			m_buffer = spdlog::memory_buf_t();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write buffered records to log file (index file is not buffered).
+	* @throws	spdlog::spdlog_ex	When log file can not be written (buffered records are dropped).
+	******************************************************************************************************/
+	void FlushFiles()
+	{
+		if (m_fd < 0 || !m_buffer.size())
+		{
+			return;
+		}
+
+		bool written = WriteBuffer();
+		int error = errno;
+
+		if (!written)
+		{
+			throw spdlog::spdlog_ex("MsvRotatingFileSink: failed writing to file " + m_fileName, error);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Sync log file (group commit).
+	* @details		When another thread (leader) is syncing, it waits for it. Otherwise it becomes leader -
+	*					it syncs (with unlocked m_lock, so other threads can write) all records written so far.
+	*					It repeats until records written before the call are synced. Log file closed by pool is
+	*					synced by new descriptor (it is not added to pool).
+	* @param[in]	lock		Locked m_lock.
+	* @throws		spdlog::spdlog_ex	When log file can not be synced.
+	******************************************************************************************************/
+	void SyncFile(std::unique_lock<std::mutex>& lock)
+	{
+		uint64_t target = m_writeSequence;
+
+		while (m_syncedSequence < target)
+		{
+			if (m_syncing)
+			{
+				m_syncedCondition.wait(lock);
+				continue;
+			}
+
+			//log file might be rotated (closed) while it is synced -> sync its duplicate
+			FlushFiles();
+			m_syncing = true;
+			uint64_t sequence = m_writeSequence;
+			int fd = -1;
+			if (m_fd < 0)
+			{
+				//log file was closed by pool without sync
+				fd = OpenFd(m_fileName, false);
+			}
+			else
+			{
+#ifdef _WIN32
+				fd = _dup(m_fd);
+#else
+				fd = dup(m_fd);
+#endif
+			}
+
+			lock.unlock();
+			int result = fd >= 0 ? SyncFd(fd) : -1;
+			int error = errno;
+			if (fd >= 0)
+			{
+				CloseFd(fd);
+			}
+			lock.lock();
+
+			m_syncing = false;
+			if (result == 0)
+			{
+				m_syncedSequence = std::max(m_syncedSequence, sequence);
+			}
+			m_syncedCondition.notify_all();
+
+			if (result != 0)
+			{
+				throw spdlog::spdlog_ex("MsvRotatingFileSink: failed syncing file " + m_fileName, error);
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write buffered records to log file.
+	* @details	Records are appended, or written at the end of records when log file is preallocated (file is
+	*				longer than its content then). Buffer is cleared even when write fails.
+	* @retval	true		On success.
+	* @retval	false		On error (errno is set).
+	******************************************************************************************************/
+	bool WriteBuffer()
+	{
+		bool written = WriteFd(m_fd, m_buffer.data(), m_buffer.size(), m_positionalWrites ? static_cast<int64_t>(m_fileSize) : -1);
+		if (written)
+		{
+			m_fileSize += m_buffer.size();
+		}
+		m_buffer.clear();
+
+		return written;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Trim preallocated tail.
+	* @details	Log file which was not closed (process crashed) ends with zeros of preallocated chunk.
+	*				Records are text lines, so trailing zeros are removed and records are appended after the
+	*				last one. It is done on Linux only (where log files are preallocated).
+	******************************************************************************************************/
+	void TrimPreallocatedTail()
+	{
+#ifdef __linux__
+		int fd = open(m_fileName.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			return;
+		}
+
+		size_t end = m_currentSize;
+		char block[4096];
+		while (end > 0)
+		{
+			size_t begin = end - std::min(end, sizeof(block));
+			if (pread(fd, block, end - begin, static_cast<off_t>(begin)) != static_cast<ssize_t>(end - begin))
+			{
+				//file can not be read -> keep it as it is
+				end = m_currentSize;
+				break;
+			}
+
+			size_t length = end - begin;
+			while (length > 0 && block[length - 1] == '\0')
+			{
+				--length;
+			}
+			end = begin + length;
+			if (length > 0)
+			{
+				break;
+			}
+		}
+		close(fd);
+
+		if (end < m_currentSize && ftruncate(m_fd, static_cast<off_t>(end)) == 0)
+		{
+			m_currentSize = end;
+			m_fileSize = end;
+		}
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Open file for appending.
+	* @details		Log files are not opened as stdio streams - C library keeps all opened streams in a list
+	*					which makes closing a stream slower with each opened one (it matters when log file
+	*					pool closes and opens log files frequently).
+	* @param[in]	fileName		File name (path).
+	* @param[in]	truncate		True when file should be truncated.
+	* @returns		File descriptor or -1 on error (errno is set).
+	******************************************************************************************************/
+	static int OpenFd(const std::string& fileName, bool truncate)
+	{
+		int fd = -1;
+#ifdef _WIN32
+		_sopen_s(&fd, fileName.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | _O_NOINHERIT | (truncate ? _O_TRUNC : 0),
+			_SH_DENYNO, _S_IREAD | _S_IWRITE);
+#else
+		do
+		{
+			fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0666);
+		}
+		while (fd < 0 && errno == EINTR);
+#endif
+		return fd;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Close file.
+	* @param[in]	fd		File descriptor.
+	******************************************************************************************************/
+	static void CloseFd(int fd)
+	{
+#ifdef _WIN32
+		_close(fd);
+#else
+		close(fd);
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get file size.
+	* @param[in]	fd		File descriptor.
+	* @returns		File size (in bytes).
+	******************************************************************************************************/
+	static size_t GetFdSize(int fd)
+	{
+#ifdef _WIN32
+		int64_t size = _lseeki64(fd, 0, SEEK_END);
+#else
+		int64_t size = static_cast<int64_t>(lseek(fd, 0, SEEK_END));
+#endif
+		return size > 0 ? static_cast<size_t>(size) : 0;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Write data to file.
+	* @param[in]	fd			File descriptor.
+	* @param[in]	pData		Data to write.
+	* @param[in]	size		Size of data (in bytes).
+	* @param[in]	offset	Offset in file (POSIX only, descriptor must not be opened for appending), -1 to write
+	*								at current position.
+	* @retval		true		On success.
+	* @retval		false		On error (errno is set).
+	******************************************************************************************************/
+	static bool WriteFd(int fd, const void* pData, size_t size, int64_t offset = -1)
+	{
+		const char* pBytes = static_cast<const char*>(pData);
+
+		while (size)
+		{
+#ifdef _WIN32
+			(void)offset;
+			int written = _write(fd, pBytes, static_cast<unsigned int>(std::min<size_t>(size, INT_MAX)));
+#else
+			ssize_t written = offset < 0 ? write(fd, pBytes, size) : pwrite(fd, pBytes, size, static_cast<off_t>(offset));
+#endif
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return false;
+			}
+
+			pBytes += written;
+			size -= static_cast<size_t>(written);
+			if (offset >= 0)
+			{
+				offset += written;
+			}
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Sync file data to disk.
+	* @param[in]	fd		File descriptor.
+	* @retval		0		On success.
+	* @retval		-1		On error (errno is set).
+	******************************************************************************************************/
+	static int SyncFd(int fd)
+	{
+#if defined(_WIN32)
+		return _commit(fd);
+#elif defined(__linux__)
+		return fdatasync(fd);
+#else
+		return fsync(fd);
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Preallocate log file.
+	* @details		Allocates next chunk of log file and extends file size with it, so sync of records written
+	*					to the chunk does not have to update file size. Records are then written at the end of
+	*					records (not appended). Preallocation is done on Linux only.
+	* @param[in]	size		Size of record which is going to be written (in bytes).
+	******************************************************************************************************/
+	void Preallocate(size_t size)
+	{
+		if (!m_preallocateSize)
+		{
+			m_preallocatedSize = SIZE_MAX;
+			return;
+		}
+
+		//preallocate up to maximum log file size (and at least record size)
+		size_t length = std::max(std::min(m_preallocateSize, m_maxLogFileSize - std::min(m_currentSize, m_maxLogFileSize)), size);
+#ifdef __linux__
+		if (!m_positionalWrites)
+		{
+			//appended records would be written after preallocated chunk
+			int flags = fcntl(m_fd, F_GETFL);
+			m_positionalWrites = flags >= 0 && fcntl(m_fd, F_SETFL, flags & ~O_APPEND) == 0;
+		}
+		if (!m_positionalWrites || fallocate(m_fd, 0, static_cast<off_t>(m_currentSize), static_cast<off_t>(length)) != 0)
+		{
+			//file system does not support it -> do not try again for this file
+			length = m_maxLogFileSize;
+		}
+#endif
+		m_preallocatedSize = m_currentSize + length;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Rotate log files (and index files).
+	* @details	log.txt -> log.1.txt, log.1.txt -> log.2.txt, ... the oldest one is deleted.
+	* @throws	spdlog::spdlog_ex	When log file can not be renamed or opened.
+	******************************************************************************************************/
+	void Rotate()
+	{
+		CloseFiles();
+
+		for (size_t i = m_maxLogFiles; i > 0; --i)
+		{
+			std::string source = CalcFileName(m_baseFileName, i - 1);
+			if (!spdlog::details::os::path_exists(source))
+			{
+				continue;
+			}
+
+			std::string target = CalcFileName(m_baseFileName, i);
+			spdlog::details::os::remove_if_exists(target);
+			if (spdlog::details::os::rename(source, target) != 0)
+			{
+				//truncate log file anyway to prevent it to grow beyond its limit
+				OpenFiles(true);
+				throw spdlog::spdlog_ex("MsvRotatingFileSink: failed renaming " + source + " to " + target, errno);
+			}
+
+			//index file may not exist (e.g. index was turned on later) -> remove stale one
+			spdlog::details::os::remove_if_exists(CalcIndexFileName(target));
+			if (spdlog::details::os::path_exists(CalcIndexFileName(source)))
+			{
+				spdlog::details::os::rename(CalcIndexFileName(source), CalcIndexFileName(target));
+			}
+		}
+
+		OpenFiles(true);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Update current index block.
+	* @details		Adds formatted record to current index block and writes block when it is full.
+	* @param[in]	msg			Logged message.
+	* @param[in]	size			Size of formatted message (in bytes).
+	******************************************************************************************************/
+	void UpdateBlock(const spdlog::details::log_msg& msg, size_t size)
+	{
+		int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+
+		if (m_block.length && m_block.length + size > UINT32_MAX)
+		{
+			//block length must fit to index entry (huge index block size)
+			WriteBlock();
+		}
+
+		if (m_block.length == 0)
+		{
+			m_block.firstTime = time;
+			m_block.offset = m_currentSize;
+		}
+
+		m_block.lastTime = time;
+		m_block.length += static_cast<uint32_t>(size);
+		m_block.levelMask |= 1u << static_cast<uint32_t>(msg.level);
+
+		if (m_block.length >= m_indexBlockSize)
+		{
+			WriteBlock();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Write current index block.
+	* @details	Appends current block to index file (when it is not empty) and starts a new one.
+	******************************************************************************************************/
+	void WriteBlock()
+	{
+		if (m_block.length)
+		{
+			WriteFd(m_indexFd, &m_block, sizeof(m_block));
+		}
+
+		ResetBlock();
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Reset current index block.
+	******************************************************************************************************/
+	void ResetBlock()
+	{
+		m_block.firstTime = 0;
+		m_block.lastTime = 0;
+		m_block.offset = 0;
+		m_block.length = 0;
+		m_block.levelMask = 0;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Base log file name (the newest log file).
+	******************************************************************************************************/
+	std::string m_baseFileName;
+
+	/**************************************************************************************************//**
+	* @brief		Current log file name.
+	******************************************************************************************************/
+	std::string m_fileName;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum size of one log file (in bytes).
+	******************************************************************************************************/
+	size_t m_maxLogFileSize;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum number of log files.
+	******************************************************************************************************/
+	size_t m_maxLogFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Size of indexed block (in bytes). Zero means no index.
+	******************************************************************************************************/
+	size_t m_indexBlockSize;
+
+	/**************************************************************************************************//**
+	* @brief		Current log file descriptor (-1 when log file is closed).
+	******************************************************************************************************/
+	int m_fd;
+
+	/**************************************************************************************************//**
+	* @brief		Current index file descriptor (-1 when index is turned off).
+	******************************************************************************************************/
+	int m_indexFd;
+
+	/**************************************************************************************************//**
+	* @brief		Write buffer (formatted records which are not written yet).
+	******************************************************************************************************/
+	spdlog::memory_buf_t m_buffer;
+
+	/**************************************************************************************************//**
+	* @brief		Current log file size (in bytes, including buffered records).
+	******************************************************************************************************/
+	size_t m_currentSize;
+
+	/**************************************************************************************************//**
+	* @brief		Size of records written to log file (in bytes, preallocated file is longer).
+	******************************************************************************************************/
+	size_t m_fileSize;
+
+	/**************************************************************************************************//**
+	* @brief		True when log file is written at the end of records (preallocated file), false to append.
+	******************************************************************************************************/
+	bool m_positionalWrites;
+
+	/**************************************************************************************************//**
+	* @brief		Current (not yet written) index block.
+	******************************************************************************************************/
+	MsvLogIndexEntry m_block;
+
+	/**************************************************************************************************//**
+	* @brief		Durable mode (flush syncs log file).
+	******************************************************************************************************/
+	bool m_durable;
+
+	/**************************************************************************************************//**
+	* @brief		Size of preallocated chunk (in bytes). Zero means no preallocation.
+	******************************************************************************************************/
+	size_t m_preallocateSize;
+
+	/**************************************************************************************************//**
+	* @brief		End of preallocated part of current log file (in bytes).
+	******************************************************************************************************/
+	size_t m_preallocatedSize;
+
+	/**************************************************************************************************//**
+	* @brief		Number of written records.
+	******************************************************************************************************/
+	uint64_t m_writeSequence;
+
+	/**************************************************************************************************//**
+	* @brief		Number of written records which are synced.
+	******************************************************************************************************/
+	uint64_t m_syncedSequence;
+
+	/**************************************************************************************************//**
+	* @brief		True when leader is syncing log file.
+	******************************************************************************************************/
+	bool m_syncing;
+
+	/**************************************************************************************************//**
+	* @brief		Condition signalled when sync finishes.
+	******************************************************************************************************/
+	std::condition_variable m_syncedCondition;
+
+	/**************************************************************************************************//**
+	* @brief		Log file pool (nullptr when number of opened log files is not limited).
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogFilePool> m_spFilePool;
+
+	/**************************************************************************************************//**
+	* @brief		Referenced flag (set when record is logged, cleared by pool).
+	******************************************************************************************************/
+	std::atomic<bool> m_referenced;
+
+	/**************************************************************************************************//**
+	* @brief		Log formatter.
+	******************************************************************************************************/
+	std::unique_ptr<spdlog::formatter> m_spFormatter;
+};
+
+
+#endif // !MARSTECH_ROTATING_FILE_SINK_H
+
+/** @} */	//End of group MLOGGING.
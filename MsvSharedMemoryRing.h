@@ -0,0 +1,1177 @@
+/**************************************************************************************************//**
+* @addtogroup	MLOGGING
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Logging Shared Memory Ring
+* @details		Cross-process logging through shared memory ring drained by a single writer.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+* @note			Available on POSIX systems only (ring is created by shm_open, e.g. in /dev/shm on Linux).
+* @see			MsvLoggerProvider::SetSharedMemoryLogging
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Logging.
+
+MarsTech Dependency Injection is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MARSTECH_SHARED_MEMORY_RING_H
+#define MARSTECH_SHARED_MEMORY_RING_H
+
+
+#ifndef _WIN32
+
+
+#include "MsvRotatingFileSink.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "spdlog/sinks/sink.h"
+#include "spdlog/pattern_formatter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Shared memory ring record.
+* @details	Log record read from @ref MsvSharedMemoryRing.
+* @author	Martin Svoboda
+* @date		18.10.2026
+******************************************************************************************************/
+struct MsvSharedMemoryRecord
+{
+	/**************************************************************************************************//**
+	* @brief		Record level.
+	******************************************************************************************************/
+	MsvLogLevel level;
+
+	/**************************************************************************************************//**
+	* @brief		Log file name (path).
+	******************************************************************************************************/
+	std::string logFile;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum size of one log file (in bytes).
+	******************************************************************************************************/
+	int maxLogFileSize;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum number of log files.
+	******************************************************************************************************/
+	int maxLogFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Formatted log line (without end of line).
+	******************************************************************************************************/
+	std::string line;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Shared memory ring.
+* @details	Bounded multi-producer single-consumer ring of fixed size slots in shared memory (one ring
+*				can be used by many processes). Each slot has sequence number - producer reserves slot by
+*				moving enqueue position, claims it and commits it by setting slot sequence (the last
+*				committed record is always complete in shared memory, so it survives producer crash).
+*				When producer crashes (or stalls) between reserve and commit, consumer skips its slot after
+*				abandon timeout. Slot which is being written is never reused until its producer finishes
+*				(it releases the slot itself) or until its producer is dead. Each ring object (producer)
+*				holds lease - write lock of one byte of shared memory file (it is released by system when
+*				process dies, even in other PID namespace) with generation number in ring header (reused
+*				lease is never mistaken for dead producer's one).
+*				Lines longer than slot are truncated.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvSharedMemorySink
+* @see		MsvSharedMemoryLogWriter
+******************************************************************************************************/
+class MsvSharedMemoryRing
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Ring magic (set when ring is initialized).
+	******************************************************************************************************/
+	static const uint64_t RingMagic = 0x4D53564C4F475233ull;
+
+	/**************************************************************************************************//**
+	* @brief		Slot size (in bytes).
+	******************************************************************************************************/
+	static const size_t SlotSize = 1024;
+
+	/**************************************************************************************************//**
+	* @brief		Number of retries of push to full ring (before record is dropped or producer waits).
+	******************************************************************************************************/
+	static const size_t FullSpinCount = 64;
+
+	/**************************************************************************************************//**
+	* @brief		Number of producer leases (ring objects which can be opened at once with known liveness).
+	******************************************************************************************************/
+	static const size_t LeaseCount = 256;
+
+	/**************************************************************************************************//**
+	* @brief			Shared memory ring constructor.
+	* @details		Opens shared memory ring or creates it when it does not exist.
+	* @param[in]	name				Ring name (shm_open name, e.g. "/msvlog").
+	* @param[in]	slotCount		Number of slots (rounded up to power of two), used when ring is created.
+	* @param[in]	mode				Access mode of created ring (0600 - owner only, 0660 - owner and group).
+	* @param[in]	group				Group of created ring (-1 keeps group of process).
+	* @throws		spdlog::spdlog_ex	When shared memory can not be opened or mapped.
+	* @warning		Anybody who can write to the ring can write records to log files of the writer.
+	******************************************************************************************************/
+	MsvSharedMemoryRing(const std::string& name, size_t slotCount = 4096, mode_t mode = 0600, gid_t group = static_cast<gid_t>(-1)):
+		m_name(name),
+		m_fd(-1),
+		m_pMemory(nullptr),
+		m_size(0),
+		m_pHeader(nullptr),
+		m_leaseToken(0),
+		m_stalledPosition(UINT64_MAX)
+	{
+		size_t count = 1;
+		while (count < slotCount)
+		{
+			count <<= 1;
+		}
+
+		bool creator = true;
+		m_fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, mode);
+		if (m_fd < 0 && errno == EEXIST)
+		{
+			creator = false;
+			m_fd = shm_open(m_name.c_str(), O_RDWR, 0);
+		}
+		if (m_fd < 0)
+		{
+			throw spdlog::spdlog_ex("MsvSharedMemoryRing: failed opening " + m_name, errno);
+		}
+
+		if (creator)
+		{
+			//mode is masked by umask when shared memory is created, group is set explicitly
+			if (fchmod(m_fd, mode) != 0 || (group != static_cast<gid_t>(-1) && fchown(m_fd, static_cast<uid_t>(-1), group) != 0))
+			{
+				int error = errno;
+				Close();
+				Remove(m_name);
+				throw spdlog::spdlog_ex("MsvSharedMemoryRing: failed setting access of " + m_name, error);
+			}
+
+			m_size = sizeof(Header) + count * SlotSize;
+			if (ftruncate(m_fd, static_cast<off_t>(m_size)) != 0)
+			{
+				Close();
+				throw spdlog::spdlog_ex("MsvSharedMemoryRing: failed resizing " + m_name, errno);
+			}
+		}
+		else
+		{
+			//wait until creator resizes shared memory
+			struct stat status;
+			for (int i = 0; fstat(m_fd, &status) == 0 && static_cast<size_t>(status.st_size) <= sizeof(Header) && i < 1000; ++i)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			m_size = static_cast<size_t>(status.st_size);
+			if (m_size <= sizeof(Header))
+			{
+				Close();
+				throw spdlog::spdlog_ex("MsvSharedMemoryRing: not initialized " + m_name);
+			}
+		}
+
+		m_pMemory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+		if (m_pMemory == MAP_FAILED)
+		{
+			m_pMemory = nullptr;
+			Close();
+			throw spdlog::spdlog_ex("MsvSharedMemoryRing: failed mapping " + m_name, errno);
+		}
+		m_pHeader = static_cast<Header*>(m_pMemory);
+
+		if (creator)
+		{
+			m_pHeader->slotCount = count;
+			m_pHeader->enqueuePosition.store(0, std::memory_order_relaxed);
+			m_pHeader->dequeuePosition.store(0, std::memory_order_relaxed);
+			m_pHeader->dropped.store(0, std::memory_order_relaxed);
+			for (size_t i = 0; i < count; ++i)
+			{
+				GetSlot(i)->sequence.store(FreeSequence(i), std::memory_order_relaxed);
+				GetSlot(i)->producer.store(0, std::memory_order_relaxed);
+			}
+			m_pHeader->magic.store(RingMagic, std::memory_order_release);
+		}
+		else
+		{
+			for (int i = 0; m_pHeader->magic.load(std::memory_order_acquire) != RingMagic && i < 1000; ++i)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			if (m_pHeader->magic.load(std::memory_order_acquire) != RingMagic || sizeof(Header) + m_pHeader->slotCount * SlotSize > m_size)
+			{
+				Close();
+				throw spdlog::spdlog_ex("MsvSharedMemoryRing: not initialized " + m_name);
+			}
+		}
+
+		AcquireLease();
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Shared memory ring destructor.
+	* @details	Unmaps shared memory. Ring (and its records) stays in shared memory.
+	* @see		Remove
+	******************************************************************************************************/
+	~MsvSharedMemoryRing()
+	{
+		Close();
+	}
+
+	MsvSharedMemoryRing(const MsvSharedMemoryRing&) = delete;
+	MsvSharedMemoryRing& operator= (const MsvSharedMemoryRing&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief			Remove ring.
+	* @details		Removes ring name from shared memory (mapped rings stay valid until they are closed).
+	* @param[in]	name		Ring name.
+	******************************************************************************************************/
+	static void Remove(const std::string& name)
+	{
+		shm_unlink(name.c_str());
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Push record.
+	* @details		Reserves slot, copies record to it and commits it. When ring is full (or writer is not
+	*					running), it retries a few times (and until timeout elapses when it is set), then the record
+	*					is dropped (and counted). Logging thread is not blocked by default.
+	* @param[in]	level				Record level.
+	* @param[in]	logFile			Log file name (path).
+	* @param[in]	maxLogFileSize	Maximum size of one log file (in bytes).
+	* @param[in]	maxLogFiles		Maximum number of log files.
+	* @param[in]	line				Formatted log line (without end of line).
+	* @param[in]	lineLength		Length of formatted log line.
+	* @param[in]	timeout			Maximum time to wait for free slot (zero - do not wait).
+	* @retval		true				When record was committed.
+	* @retval		false				When record was dropped.
+	******************************************************************************************************/
+	bool Push(MsvLogLevel level, const std::string& logFile, int maxLogFileSize, int maxLogFiles, const char* line, size_t lineLength, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+	{
+		if (logFile.size() > DataSize / 2)
+		{
+			m_pHeader->dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		std::chrono::steady_clock::time_point deadline;
+		bool waiting = false;
+		size_t spins = 0;
+		uint64_t position = m_pHeader->enqueuePosition.load(std::memory_order_relaxed);
+		Slot* pSlot = nullptr;
+
+		for (;;)
+		{
+			pSlot = GetSlot(position);
+			uint64_t sequence = pSlot->sequence.load(std::memory_order_acquire);
+
+			if (sequence == FreeSequence(position))
+			{
+				if (m_pHeader->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (sequence < FreeSequence(position))
+			{
+				//ring is full -> retry shortly (writer might just be freeing slots), wait only with timeout
+				if (++spins > FullSpinCount)
+				{
+					if (!waiting && timeout.count() > 0)
+					{
+						deadline = std::chrono::steady_clock::now() + timeout;
+						waiting = true;
+					}
+					if (!waiting || std::chrono::steady_clock::now() > deadline)
+					{
+						m_pHeader->dropped.fetch_add(1, std::memory_order_relaxed);
+						return false;
+					}
+
+					std::this_thread::yield();
+				}
+				position = m_pHeader->enqueuePosition.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				position = m_pHeader->enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		//claim slot - consumer might have skipped it when this producer was stalled too long (then the
+		//slot can be reused and this producer must not touch it)
+		uint64_t expected = FreeSequence(position);
+		if (pSlot->sequence.load(std::memory_order_relaxed) != expected)
+		{
+			return false;
+		}
+		pSlot->producer.store(m_leaseToken, std::memory_order_relaxed);
+		if (!pSlot->sequence.compare_exchange_strong(expected, expected + WritingState, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		lineLength = std::min(lineLength, DataSize - logFile.size());
+		pSlot->level = static_cast<uint32_t>(level);
+		pSlot->logFileLength = static_cast<uint32_t>(logFile.size());
+		pSlot->lineLength = static_cast<uint32_t>(lineLength);
+		pSlot->maxLogFileSize = maxLogFileSize;
+		pSlot->maxLogFiles = maxLogFiles;
+		std::memcpy(pSlot->data, logFile.data(), logFile.size());
+		std::memcpy(pSlot->data + logFile.size(), line, lineLength);
+
+		//commit - when consumer skipped the slot while it was written, it waits for this producer to
+		//release it (the record is counted as dropped by consumer)
+		expected = FreeSequence(position) + WritingState;
+		if (!pSlot->sequence.compare_exchange_strong(expected, FreeSequence(position) + CommittedState, std::memory_order_release, std::memory_order_relaxed))
+		{
+			pSlot->sequence.store(FreeSequence(position + m_pHeader->slotCount), std::memory_order_release);
+			return false;
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Pop record.
+	* @details		Reads the oldest committed record. Slot which was reserved but not committed for longer
+	*					than abandon timeout (producer crashed) is skipped. Slot is released before dequeue
+	*					position is advanced, so position whose slot is already released (writer crashed between
+	*					these steps) is recognized as consumed.
+	* @param[out]	record				Read record.
+	* @param[in]	abandonTimeout		Time after which reserved but not committed slot is skipped.
+	* @retval		true					When record was read.
+	* @retval		false					When there is no committed record.
+	* @warning		Only one consumer (writer) can pop records.
+	******************************************************************************************************/
+	bool Pop(MsvSharedMemoryRecord& record, std::chrono::milliseconds abandonTimeout = std::chrono::milliseconds(1000))
+	{
+		for (;;)
+		{
+			uint64_t position = m_pHeader->dequeuePosition.load(std::memory_order_relaxed);
+			Slot* pSlot = GetSlot(position);
+			uint64_t sequence = pSlot->sequence.load(std::memory_order_acquire);
+
+			if (sequence == FreeSequence(position) + CommittedState)
+			{
+				size_t logFileLength = std::min<size_t>(pSlot->logFileLength, DataSize);
+				size_t lineLength = std::min<size_t>(pSlot->lineLength, DataSize - logFileLength);
+
+				record.level = static_cast<MsvLogLevel>(pSlot->level);
+				record.logFile.assign(pSlot->data, logFileLength);
+				record.maxLogFileSize = pSlot->maxLogFileSize;
+				record.maxLogFiles = pSlot->maxLogFiles;
+				record.line.assign(pSlot->data + logFileLength, lineLength);
+
+				pSlot->sequence.store(FreeSequence(position + m_pHeader->slotCount), std::memory_order_release);
+				m_pHeader->dequeuePosition.store(position + 1, std::memory_order_relaxed);
+				m_stalledPosition = UINT64_MAX;
+				return true;
+			}
+
+			//slot is released (or skipped) before dequeue position is advanced - when previous writer died
+			//between these two steps, the position is already consumed -> just advance it
+			if (sequence >= FreeSequence(position + m_pHeader->slotCount) || sequence == FreeSequence(position) + AbandonedState)
+			{
+				m_pHeader->dequeuePosition.store(position + 1, std::memory_order_relaxed);
+				m_stalledPosition = UINT64_MAX;
+				continue;
+			}
+
+			if (m_pHeader->enqueuePosition.load(std::memory_order_relaxed) <= position)
+			{
+				//ring is empty - but producers can be blocked by skipped slot of dead producer (previous lap)
+				if (position >= m_pHeader->slotCount && sequence == FreeSequence(position - m_pHeader->slotCount) + AbandonedState &&
+					!IsProducerAlive(pSlot->producer.load(std::memory_order_relaxed)))
+				{
+					pSlot->sequence.compare_exchange_strong(sequence, FreeSequence(position), std::memory_order_acq_rel);
+				}
+				return false;
+			}
+
+			if (sequence != FreeSequence(position) && sequence != FreeSequence(position) + WritingState)
+			{
+				return false;
+			}
+
+			//slot is reserved but not committed
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (m_stalledPosition != position)
+			{
+				m_stalledPosition = position;
+				m_stalledSince = now;
+				return false;
+			}
+			if (now - m_stalledSince < abandonTimeout)
+			{
+				return false;
+			}
+
+			//producer crashed (or it is stalled too long) -> skip its slot, slot which is being written by
+			//living producer is released by the producer when it finishes
+			uint64_t released = FreeSequence(position + m_pHeader->slotCount);
+			if (sequence != FreeSequence(position) && IsProducerAlive(pSlot->producer.load(std::memory_order_relaxed)))
+			{
+				released = FreeSequence(position) + AbandonedState;
+			}
+			if (pSlot->sequence.compare_exchange_strong(sequence, released, std::memory_order_acq_rel))
+			{
+				m_pHeader->dequeuePosition.store(position + 1, std::memory_order_relaxed);
+				m_pHeader->dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+			m_stalledPosition = UINT64_MAX;
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get file descriptor.
+	* @returns	File descriptor of shared memory (it is used to lock single writer).
+	******************************************************************************************************/
+	int GetFd() const
+	{
+		return m_fd;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Get dropped records count.
+	* @returns	Number of dropped records (by all producers).
+	******************************************************************************************************/
+	uint64_t GetDropped() const
+	{
+		return m_pHeader->dropped.load(std::memory_order_relaxed);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Ring header.
+	******************************************************************************************************/
+	struct Header
+	{
+		/**************************************************************************************************//**
+		* @brief		Ring magic (set when ring is initialized).
+		******************************************************************************************************/
+		std::atomic<uint64_t> magic;
+
+		/**************************************************************************************************//**
+		* @brief		Number of slots (power of two).
+		******************************************************************************************************/
+		uint64_t slotCount;
+
+		/**************************************************************************************************//**
+		* @brief		Dropped records count.
+		******************************************************************************************************/
+		std::atomic<uint64_t> dropped;
+
+		/**************************************************************************************************//**
+		* @brief		Enqueue position (own cache line).
+		******************************************************************************************************/
+		alignas(64) std::atomic<uint64_t> enqueuePosition;
+
+		/**************************************************************************************************//**
+		* @brief		Dequeue position (own cache line).
+		******************************************************************************************************/
+		alignas(64) std::atomic<uint64_t> dequeuePosition;
+
+		/**************************************************************************************************//**
+		* @brief		Lease generations (incremented when lease is acquired).
+		******************************************************************************************************/
+		alignas(64) std::atomic<uint64_t> leaseGenerations[LeaseCount];
+
+		/**************************************************************************************************//**
+		* @brief		Padding (slots start at cache line).
+		******************************************************************************************************/
+		alignas(64) char padding[64];
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Slot header size (in bytes).
+	******************************************************************************************************/
+	static const size_t SlotHeaderSize = 40;
+
+	/**************************************************************************************************//**
+	* @brief		Slot data size (in bytes).
+	******************************************************************************************************/
+	static const size_t DataSize = SlotSize - SlotHeaderSize;
+
+	/**************************************************************************************************//**
+	* @brief		Ring slot.
+	******************************************************************************************************/
+	struct Slot
+	{
+		/**************************************************************************************************//**
+		* @brief		Slot sequence (4 * position + slot state).
+		******************************************************************************************************/
+		std::atomic<uint64_t> sequence;
+
+		/**************************************************************************************************//**
+		* @brief		Record level.
+		******************************************************************************************************/
+		uint32_t level;
+
+		/**************************************************************************************************//**
+		* @brief		Length of log file name.
+		******************************************************************************************************/
+		uint32_t logFileLength;
+
+		/**************************************************************************************************//**
+		* @brief		Length of log line.
+		******************************************************************************************************/
+		uint32_t lineLength;
+
+		/**************************************************************************************************//**
+		* @brief		Maximum size of one log file (in bytes).
+		******************************************************************************************************/
+		int32_t maxLogFileSize;
+
+		/**************************************************************************************************//**
+		* @brief		Maximum number of log files.
+		******************************************************************************************************/
+		int32_t maxLogFiles;
+
+		/**************************************************************************************************//**
+		* @brief		Lease token of producer which claimed slot (zero - unknown producer).
+		******************************************************************************************************/
+		std::atomic<uint64_t> producer;
+
+		/**************************************************************************************************//**
+		* @brief		Log file name followed by log line.
+		******************************************************************************************************/
+		char data[DataSize];
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Slot state - claimed, record is being written.
+	******************************************************************************************************/
+	static const uint64_t WritingState = 1;
+
+	/**************************************************************************************************//**
+	* @brief		Slot state - record is committed.
+	******************************************************************************************************/
+	static const uint64_t CommittedState = 2;
+
+	/**************************************************************************************************//**
+	* @brief		Slot state - skipped by consumer while it was written (producer releases it).
+	******************************************************************************************************/
+	static const uint64_t AbandonedState = 3;
+
+	/**************************************************************************************************//**
+	* @brief			Get sequence of free slot.
+	* @param[in]	position		Ring position.
+	* @returns		Sequence of slot which is free for position (slot state is added to it).
+	******************************************************************************************************/
+	static uint64_t FreeSequence(uint64_t position)
+	{
+		return position * 4;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Lock lease.
+	* @details		Sets (or tests) open file description write lock of lease byte (lock is owned by ring
+	*					object, not by process, and it is released when the object is closed or process dies).
+	* @param[in]	lease			Lease index.
+	* @param[in]	test			Only test whether the lease is locked by other ring object.
+	* @retval		true			When lease was locked (test - when lease is locked by other ring object).
+	* @retval		false			When lease is locked by other ring object (test - when lease is not locked).
+	******************************************************************************************************/
+	bool LockLease(size_t lease, bool test) const
+	{
+#ifdef F_OFD_SETLK
+		struct flock lock;
+		std::memset(&lock, 0, sizeof(lock));
+		lock.l_type = F_WRLCK;
+		lock.l_whence = SEEK_SET;
+		lock.l_start = static_cast<off_t>(lease);
+		lock.l_len = 1;
+
+		if (fcntl(m_fd, test ? F_OFD_GETLK : F_OFD_SETLK, &lock) != 0)
+		{
+			//failed test is handled as locked lease (producer is considered alive)
+			return test;
+		}
+
+		return !test || lock.l_type != F_UNLCK;
+#else
+		//process locks can not distinguish ring objects of one process -> producers have no lease
+		(void)lease;
+		return test;
+#endif
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Acquire lease.
+	* @details	Locks the first free lease and increments its generation. Producer without lease (all leases
+	*				are taken or open file description locks are not supported) uses zero token - it is always
+	*				considered alive (its abandoned slot is not reused).
+	******************************************************************************************************/
+	void AcquireLease()
+	{
+		for (size_t lease = 0; lease < LeaseCount; ++lease)
+		{
+			if (LockLease(lease, false))
+			{
+				uint64_t generation = m_pHeader->leaseGenerations[lease].fetch_add(1, std::memory_order_acq_rel) + 1;
+				m_leaseToken = generation * LeaseCount + lease;
+				return;
+			}
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Check producer.
+	* @param[in]	producer		Producer lease token.
+	* @retval		true			When producer still holds its lease (or it is not known).
+	* @retval		false			When producer released its lease (it is dead or its ring was closed).
+	******************************************************************************************************/
+	bool IsProducerAlive(uint64_t producer) const
+	{
+		if (producer == 0 || producer == m_leaseToken)
+		{
+			return true;
+		}
+
+		size_t lease = static_cast<size_t>(producer % LeaseCount);
+		if (m_pHeader->leaseGenerations[lease].load(std::memory_order_acquire) != producer / LeaseCount)
+		{
+			//lease was acquired again -> its previous owner released it
+			return false;
+		}
+
+		return LockLease(lease, true);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get slot.
+	* @param[in]	position		Ring position.
+	* @returns		Slot for position.
+	******************************************************************************************************/
+	Slot* GetSlot(uint64_t position) const
+	{
+		return reinterpret_cast<Slot*>(static_cast<char*>(m_pMemory) + sizeof(Header) + (position & (m_pHeader->slotCount - 1)) * SlotSize);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Unmap and close shared memory.
+	******************************************************************************************************/
+	void Close()
+	{
+		if (m_pMemory)
+		{
+			munmap(m_pMemory, m_size);
+			m_pMemory = nullptr;
+		}
+
+		if (m_fd >= 0)
+		{
+			close(m_fd);
+			m_fd = -1;
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Ring name.
+	******************************************************************************************************/
+	std::string m_name;
+
+	/**************************************************************************************************//**
+	* @brief		Shared memory file descriptor.
+	******************************************************************************************************/
+	int m_fd;
+
+	/**************************************************************************************************//**
+	* @brief		Mapped shared memory.
+	******************************************************************************************************/
+	void* m_pMemory;
+
+	/**************************************************************************************************//**
+	* @brief		Size of mapped shared memory (in bytes).
+	******************************************************************************************************/
+	size_t m_size;
+
+	/**************************************************************************************************//**
+	* @brief		Ring header (begin of mapped shared memory).
+	******************************************************************************************************/
+	Header* m_pHeader;
+
+	/**************************************************************************************************//**
+	* @brief		Lease token of this ring object (generation * LeaseCount + lease, zero - no lease).
+	******************************************************************************************************/
+	uint64_t m_leaseToken;
+
+	/**************************************************************************************************//**
+	* @brief		Position of reserved but not committed slot (consumer only).
+	******************************************************************************************************/
+	uint64_t m_stalledPosition;
+
+	/**************************************************************************************************//**
+	* @brief		Time when slot at stalled position was found not committed (consumer only).
+	******************************************************************************************************/
+	std::chrono::steady_clock::time_point m_stalledSince;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Shared memory sink.
+* @details	Sink which formats records (in producer process - process id and thread id are producer's)
+*				and pushes them to @ref MsvSharedMemoryRing. Records are written to log file by
+*				@ref MsvSharedMemoryLogWriter.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvSharedMemoryRing
+* @see		MsvSharedMemoryLogWriter
+******************************************************************************************************/
+class MsvSharedMemorySink:
+	public spdlog::sinks::sink
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Shared memory sink constructor.
+	* @param[in]	spRing				Shared memory ring.
+	* @param[in]	logFile				Log file name (relative to log folder of writer).
+	* @param[in]	maxLogFileSize		Maximum size of one log file (in bytes).
+	* @param[in]	maxLogFiles			Maximum number of log files.
+	* @param[in]	pushTimeout			Maximum time to wait for free slot of full ring (zero - drop record).
+	******************************************************************************************************/
+	MsvSharedMemorySink(std::shared_ptr<MsvSharedMemoryRing> spRing, const std::string& logFile, int maxLogFileSize, int maxLogFiles, std::chrono::milliseconds pushTimeout = std::chrono::milliseconds(0)):
+		m_spRing(spRing),
+		m_logFile(logFile),
+		m_maxLogFileSize(maxLogFileSize),
+		m_maxLogFiles(maxLogFiles),
+		m_pushTimeout(pushTimeout),
+		m_spFormatter(new spdlog::pattern_formatter())
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvSharedMemorySink() {  }
+
+	/**************************************************************************************************//**
+	* @brief			Log message.
+	* @details		Formats message and pushes it to shared memory ring.
+	* @param[in]	msg		Message to log.
+	******************************************************************************************************/
+	virtual void log(const spdlog::details::log_msg& msg) override
+	{
+		spdlog::memory_buf_t formatted;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_spFormatter->format(msg, formatted);
+		}
+
+		//writer adds end of line again
+		size_t length = formatted.size();
+		while (length && (formatted.data()[length - 1] == '\n' || formatted.data()[length - 1] == '\r'))
+		{
+			--length;
+		}
+
+		m_spRing->Push(msg.level, m_logFile, m_maxLogFileSize, m_maxLogFiles, formatted.data(), length, m_pushTimeout);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Flush (records are flushed by writer).
+	******************************************************************************************************/
+	virtual void flush() override
+	{
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log pattern.
+	* @param[in]	pattern		Log pattern.
+	******************************************************************************************************/
+	virtual void set_pattern(const std::string& pattern) override
+	{
+		set_formatter(std::unique_ptr<spdlog::formatter>(new spdlog::pattern_formatter(pattern)));
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log formatter.
+	* @param[in]	sink_formatter		Log formatter.
+	******************************************************************************************************/
+	virtual void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_spFormatter = std::move(sink_formatter);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Locking object (formatter is not thread safe).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Shared memory ring.
+	******************************************************************************************************/
+	std::shared_ptr<MsvSharedMemoryRing> m_spRing;
+
+	/**************************************************************************************************//**
+	* @brief		Log file name (path).
+	******************************************************************************************************/
+	std::string m_logFile;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum size of one log file (in bytes).
+	******************************************************************************************************/
+	int m_maxLogFileSize;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum number of log files.
+	******************************************************************************************************/
+	int m_maxLogFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum time to wait for free slot of full ring.
+	******************************************************************************************************/
+	std::chrono::milliseconds m_pushTimeout;
+
+	/**************************************************************************************************//**
+	* @brief		Log formatter.
+	******************************************************************************************************/
+	std::unique_ptr<spdlog::formatter> m_spFormatter;
+};
+
+
+/**************************************************************************************************//**
+* @brief		Shared memory log writer.
+* @details	The single writer of shared memory ring. It runs thread which drains records from ring to
+*				rotating log files (one @ref MsvRotatingFileSink per log file). Only one writer can run
+*				for a ring (it is ensured by exclusive lock of shared memory, which is released even when
+*				writer process crashes). Records pushed before writer starts (or while it is not running)
+*				stay in ring and they are written when writer starts.
+*				Log file names come from shared memory, so they are resolved under log folder of writer and
+*				records with absolute paths or ".." are rejected.
+* @author	Martin Svoboda
+* @date		18.10.2026
+* @see		MsvSharedMemoryRing
+* @see		MsvSharedMemorySink
+******************************************************************************************************/
+class MsvSharedMemoryLogWriter
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Maximum number of opened log files (when writer uses its own log file pool).
+	******************************************************************************************************/
+	static const size_t DefaultMaxOpenFiles = 64;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum number of log file sinks (the least recently used one is destroyed).
+	******************************************************************************************************/
+	static const size_t MaxSinkCount = 1024;
+
+	/**************************************************************************************************//**
+	* @brief			Shared memory log writer constructor.
+	* @details		Locks ring for writing and starts writing thread.
+	* @param[in]	spRing				Shared memory ring.
+	* @param[in]	logFolder			Log folder (all log files are written to it).
+	* @param[in]	indexBlockSize		Size of indexed block of log files (zero means no index).
+	* @param[in]	spFilePool			Log file pool which limits opened log files (nullptr - writer uses its own
+	*											pool with @ref DefaultMaxOpenFiles).
+	* @throws		spdlog::spdlog_ex	When another writer is running.
+	******************************************************************************************************/
+	MsvSharedMemoryLogWriter(std::shared_ptr<MsvSharedMemoryRing> spRing, const std::string& logFolder, size_t indexBlockSize = 0, std::shared_ptr<MsvLogFilePool> spFilePool = nullptr):
+		m_spRing(spRing),
+		m_logFolder(logFolder),
+		m_indexBlockSize(indexBlockSize),
+		m_spFilePool(spFilePool ? spFilePool : std::make_shared<MsvLogFilePool>(DefaultMaxOpenFiles)),
+		m_rejected(0),
+		m_useCounter(0),
+		m_stop(false)
+	{
+		if (flock(m_spRing->GetFd(), LOCK_EX | LOCK_NB) != 0)
+		{
+			throw spdlog::spdlog_ex("MsvSharedMemoryLogWriter: another writer is running", errno);
+		}
+
+		m_thread = std::thread([this]() { Write(); });
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Shared memory log writer destructor.
+	* @details	Stops writing thread (all committed records are written) and unlocks ring.
+	******************************************************************************************************/
+	~MsvSharedMemoryLogWriter()
+	{
+		m_stop.store(true);
+		m_thread.join();
+
+		flock(m_spRing->GetFd(), LOCK_UN);
+	}
+
+	MsvSharedMemoryLogWriter(const MsvSharedMemoryLogWriter&) = delete;
+	MsvSharedMemoryLogWriter& operator= (const MsvSharedMemoryLogWriter&) = delete;
+
+	/**************************************************************************************************//**
+	* @brief		Get rejected records count.
+	* @returns	Number of records rejected because of their log file name or limits.
+	******************************************************************************************************/
+	uint64_t GetRejected() const
+	{
+		return m_rejected.load(std::memory_order_relaxed);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Resolve log file.
+	* @details		Resolves log file name (from shared memory) under log folder. Only relative names which
+	*					stay in log folder are accepted. Empty and "." components are removed, so different names
+	*					of the same log file (e.g. "a.txt" and "./a.txt") are resolved to the same path.
+	* @param[in]	logFolder		Log folder.
+	* @param[in]	logFile			Log file name (relative to log folder).
+	* @param[out]	logFilePath		Log file path.
+	* @retval		true				When log file name is accepted.
+	* @retval		false				When log file name is empty (or "."), absolute or it contains "..".
+	******************************************************************************************************/
+	static bool ResolveLogFile(const std::string& logFolder, const std::string& logFile, std::string& logFilePath)
+	{
+		if (logFile.empty() || logFile[0] == '/' || logFile[0] == '\\' || logFile.find('\0') != std::string::npos)
+		{
+			return false;
+		}
+
+		std::string normalized;
+		for (size_t begin = 0; begin <= logFile.size();)
+		{
+			size_t end = std::min(logFile.find('/', begin), logFile.size());
+
+			//backslash is not separator on POSIX, but ".." must not be accepted between backslashes either
+			for (size_t partBegin = begin; partBegin <= end;)
+			{
+				size_t partEnd = std::min(logFile.find('\\', partBegin), end);
+				if (logFile.compare(partBegin, partEnd - partBegin, "..") == 0)
+				{
+					return false;
+				}
+				partBegin = partEnd + 1;
+			}
+
+			if (end > begin && logFile.compare(begin, end - begin, ".") != 0)
+			{
+				normalized.append(normalized.empty() ? "" : "/").append(logFile, begin, end - begin);
+			}
+			begin = end + 1;
+		}
+		if (normalized.empty())
+		{
+			return false;
+		}
+
+		logFilePath = logFolder + "/" + normalized;
+		return true;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Write records.
+	* @details	Writing thread main function. Flushes log files when ring is empty.
+	******************************************************************************************************/
+	void Write()
+	{
+		MsvSharedMemoryRecord record;
+		bool dirty = false;
+
+		for (;;)
+		{
+			if (m_spRing->Pop(record))
+			{
+				WriteRecord(record);
+				dirty = true;
+				continue;
+			}
+
+			if (dirty)
+			{
+				for (std::map<std::string, WriterSink>::value_type& sink : m_sinks)
+				{
+					sink.second.spSink->flush();
+				}
+				dirty = false;
+			}
+
+			if (m_stop.load())
+			{
+				return;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Write record.
+	* @param[in]	record		Record to write.
+	******************************************************************************************************/
+	void WriteRecord(const MsvSharedMemoryRecord& record)
+	{
+		std::string logFilePath;
+		if (!ResolveLogFile(m_logFolder, record.logFile, logFilePath) || record.maxLogFileSize <= 0 || record.maxLogFiles < 0)
+		{
+			m_rejected.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		try
+		{
+			std::map<std::string, WriterSink>::iterator it = m_sinks.find(logFilePath);
+			if (it == m_sinks.end())
+			{
+				if (m_sinks.size() >= MaxSinkCount)
+				{
+					RemoveLeastRecentlyUsedSink();
+				}
+
+				std::shared_ptr<MsvRotatingFileSink> spSink(new MsvRotatingFileSink(logFilePath, record.maxLogFileSize, record.maxLogFiles, m_indexBlockSize));
+				//records are formatted by producers
+				spSink->set_pattern("%v");
+				spSink->SetFilePool(m_spFilePool);
+				it = m_sinks.insert(std::make_pair(logFilePath, WriterSink{spSink, 0})).first;
+			}
+
+			it->second.lastUse = ++m_useCounter;
+			it->second.spSink->log(spdlog::details::log_msg(spdlog::string_view_t(), record.level, spdlog::string_view_t(record.line.data(), record.line.size())));
+		}
+		catch (...)
+		{
+			//log file can not be opened or written -> record is lost, continue with next one
+			m_sinks.erase(logFilePath);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Remove the least recently used sink.
+	* @details	Flushes and destroys sink of log file which was not written for the longest time (log file
+	*				names come from producers, so number of sinks must be limited).
+	******************************************************************************************************/
+	void RemoveLeastRecentlyUsedSink()
+	{
+		std::map<std::string, WriterSink>::iterator oldest = m_sinks.begin();
+		for (std::map<std::string, WriterSink>::iterator it = m_sinks.begin(); it != m_sinks.end(); ++it)
+		{
+			if (it->second.lastUse < oldest->second.lastUse)
+			{
+				oldest = it;
+			}
+		}
+
+		if (oldest != m_sinks.end())
+		{
+			oldest->second.spSink->flush();
+			m_sinks.erase(oldest);
+		}
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Log file sink of writer.
+	******************************************************************************************************/
+	struct WriterSink
+	{
+		/**************************************************************************************************//**
+		* @brief		Rotating file sink.
+		******************************************************************************************************/
+		std::shared_ptr<MsvRotatingFileSink> spSink;
+
+		/**************************************************************************************************//**
+		* @brief		Value of use counter when sink was written last time.
+		******************************************************************************************************/
+		uint64_t lastUse;
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Shared memory ring.
+	******************************************************************************************************/
+	std::shared_ptr<MsvSharedMemoryRing> m_spRing;
+
+	/**************************************************************************************************//**
+	* @brief		Log folder.
+	******************************************************************************************************/
+	std::string m_logFolder;
+
+	/**************************************************************************************************//**
+	* @brief		Size of indexed block of log files (zero means no index).
+	******************************************************************************************************/
+	size_t m_indexBlockSize;
+
+	/**************************************************************************************************//**
+	* @brief		Log file pool (limits opened log files).
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogFilePool> m_spFilePool;
+
+	/**************************************************************************************************//**
+	* @brief		Number of rejected records.
+	******************************************************************************************************/
+	std::atomic<uint64_t> m_rejected;
+
+	/**************************************************************************************************//**
+	* @brief		Counter of written records (it orders sinks by their last use).
+	******************************************************************************************************/
+	uint64_t m_useCounter;
+
+	/**************************************************************************************************//**
+	* @brief		Log file sinks (by resolved log file path).
+	******************************************************************************************************/
+	std::map<std::string, WriterSink> m_sinks;
+
+	/**************************************************************************************************//**
+	* @brief		Stop flag.
+	******************************************************************************************************/
+	std::atomic<bool> m_stop;
+
+	/**************************************************************************************************//**
+	* @brief		Writing thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+};
+
+
+#endif // !_WIN32
+
+
+#endif // !MARSTECH_SHARED_MEMORY_RING_H
+
+/** @} */	//End of group MLOGGING.
@@ -37,14 +37,21 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "mlogging.h"
+#include "MsvRotatingFileSink.h"
+#include "MsvLazySink.h"
+#include "MsvAdmissionControlSink.h"
+#include "MsvLoggingConfig.h"
+#include "MsvSharedMemoryRing.h"
+#include "MsvLogSubscription.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
-#include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/null_sink.h"
 
 #include <mutex>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 MSV_ENABLE_WARNINGS
 
@@ -75,14 +82,31 @@ public:
 		m_logFile(logFile),
 		m_maxLogFileSize(maxLogFileSize),
 		m_maxLogFiles(maxLogFiles),
-		m_logLevel(spdlog::level::info)
+		m_logLevel(spdlog::level::info),
+		m_logIndexBlockSize(0),
+		m_lazySinkOpening(false),
+		m_durableFlush(false),
+		m_preallocateSize(0),
+		m_spSubscriptionSink(new MsvLogSubscriptionSink()),
+		m_configVersion(0),
+		m_sharedMemoryPushTimeout(0)
 	{
 	}
 
 	/**************************************************************************************************//**
 	* @brief		Virtual destructor.
 	******************************************************************************************************/
-	virtual ~MsvLoggerProvider() {  }
+	virtual ~MsvLoggerProvider()
+	{
+		//stop watching configuration and reporting dropped records before provider members are destroyed
+		std::unique_ptr<MsvConfigFileWatcher> spConfigWatcher;
+		std::unique_ptr<MsvAdmissionReporter> spAdmissionReporter;
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_lock);
+			spConfigWatcher = std::move(m_spConfigWatcher);
+			spAdmissionReporter = std::move(m_spAdmissionReporter);
+		}
+	}
 
 	/**************************************************************************************************//**
 	* @copydoc IMsvLoggerProvider::GetLogger(const char*) const
@@ -103,30 +127,16 @@ public:
 
 		try
 		{
-			//try to get logger if already exists
-			spLogger = spdlog::get(loggerName);
-
-			if (!spLogger)
+			//try to get logger if already exists (loggers are not registered to spdlog, each provider has its own)
+			std::map<std::string, std::shared_ptr<MsvLogger>>::const_iterator it = m_loggers.find(loggerName);
+			if (it != m_loggers.end())
+			{
+				spLogger = it->second;
+			}
+			else
 			{
 				//logger does not exists -> create new one
-				std::string logFilePath(m_logFolder + "/" + logFile);
-				std::map<std::string, std::shared_ptr<spdlog::sinks::rotating_file_sink_mt>>::const_iterator it = m_sharedSinks.find(logFilePath);
-				if (it != m_sharedSinks.end())
-				{
-					spLogger.reset(new (std::nothrow) spdlog::logger(loggerName, it->second));
-				}
-				else
-				{
-					std::shared_ptr<spdlog::sinks::rotating_file_sink_mt> spSharedSink(new (std::nothrow) spdlog::sinks::rotating_file_sink_mt(m_logFolder + "/" + logFile, maxLogFileSize, maxLogFiles));
-					spLogger.reset(new (std::nothrow) spdlog::logger(loggerName, spSharedSink));
-					m_sharedSinks[logFilePath] = spSharedSink;
-				}				
-
-				spLogger->set_level(m_logLevel);
-				//[2014-31-10 23:46:59.256789123] [processId] [threadId] [loggerName] [severity] "message"
-				//[2014-31-10 23:46:59.256789123] [1111] [2222] [MsvLogger] [info] Some message
-				spLogger->set_pattern("[%Y-%m-%d %H:%M:%S.%F] [%P] [%t] [%n] [%l] %v");
-				spLogger->flush_on(spdlog::level::err);
+				spLogger = CreateLogger(loggerName, GetSharedSink(logFile, maxLogFileSize, maxLogFiles));
 			}
 		}
 		catch (...)
@@ -138,8 +148,39 @@ public:
 		return spLogger;
 	}
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvLoggerProvider::RegisterLoggers(const std::vector<std::string>&) const
+	******************************************************************************************************/
+	virtual bool RegisterLoggers(const std::vector<std::string>& loggerNames) const override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		try
+		{
+			//all loggers share the same (default) sink -> find or create it just once
+			std::shared_ptr<spdlog::sinks::sink> spSharedSink = GetSharedSink(m_logFile.c_str(), m_maxLogFileSize, m_maxLogFiles);
+
+			for (const std::string& loggerName : loggerNames)
+			{
+				if (m_loggers.find(loggerName) == m_loggers.end())
+				{
+					CreateLogger(loggerName, spSharedSink);
+				}
+			}
+		}
+		catch (...)
+		{
+			//exception caught -> some loggers have not been registered
+			return false;
+		}
+
+		return true;
+	}
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvLoggerProvider::SetLogLevel(MsvLogLevel logLevel)
+	* @note		When configuration is applied, new configuration with this level (and without levels of
+	*				loggers) is published - new loggers get this level too (until next configuration is applied).
 	******************************************************************************************************/
 	virtual void SetLogLevel(MsvLogLevel logLevel)
 	{
@@ -147,6 +188,480 @@ public:
 
 		m_logLevel = logLevel;
 		spdlog::set_level(logLevel);
+		for (std::map<std::string, std::shared_ptr<MsvLogger>>::value_type& logger : m_loggers)
+		{
+			logger.second->set_level(logLevel);
+		}
+
+		if (m_spConfig)
+		{
+			std::unique_ptr<MsvLoggingConfig> spConfig;
+			{
+				MsvAtomicSnapshot<MsvLoggingConfig>::Guard config(*m_spConfig);
+				spConfig.reset(new MsvLoggingConfig(*config.Get()));
+			}
+
+			//level is set to all loggers -> levels of loggers from configuration are not valid anymore
+			spConfig->version = ++m_configVersion;
+			spConfig->level = logLevel;
+			for (std::map<std::string, MsvLoggingConfig::Logger, std::less<>>::value_type& logger : spConfig->loggers)
+			{
+				logger.second.hasLevel = false;
+			}
+
+			m_spConfig->Publish(spConfig.release());
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvLoggerProvider::Subscribe(const char*, MsvLogLevel)
+	******************************************************************************************************/
+	virtual std::shared_ptr<IMsvLogSubscription> Subscribe(const char* loggerName = "", MsvLogLevel logLevel = spdlog::level::trace) override
+	{
+		try
+		{
+			return std::shared_ptr<IMsvLogSubscription>(new MsvLogSubscription(m_spSubscriptionSink, loggerName, logLevel));
+		}
+		catch (...)
+		{
+			//exception caught -> no subscription
+			return nullptr;
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set log index block size.
+	* @details		Turns on sparse time/level index written alongside log files ("<log file>.idx"). One index
+	*					entry (time range, offset and levels) is written for each block of log file. Index can be
+	*					used by @ref MsvLogIndexReader to read only blocks with requested time range and levels.
+	* @param[in]	blockSize		Size of indexed block (in bytes). Zero turns index off (default).
+	* @note			It is applied to log files opened after this call only.
+	* @see			MsvRotatingFileSink
+	* @see			MsvLogIndexReader
+	******************************************************************************************************/
+	void SetLogIndexBlockSize(size_t blockSize)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		m_logIndexBlockSize = blockSize;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set lazy sink opening.
+	* @details		When it is turned on, log files are not opened when logger is created, but when the first
+	*					record (which passes logger level check) is logged. Loggers which never log anything do
+	*					not cost any file handle or I/O.
+	* @param[in]	lazy		True to turn lazy opening on, false to open log files immediately (default).
+	* @note			It is applied to log files used for the first time after this call only.
+	* @see			MsvLazySink
+	******************************************************************************************************/
+	void SetLazySinkOpening(bool lazy)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		m_lazySinkOpening = lazy;
+	}
+
+#ifndef _WIN32
+	/**************************************************************************************************//**
+	* @brief			Set shared memory logging.
+	* @details		Records of this provider are not written to log files directly, but they are formatted and
+	*					pushed to shared memory ring (e.g. /dev/shm/msvlog). The ring can be shared by many processes
+	*					(each with its own provider) and the only one of them (the writer) drains it to rotating
+	*					log files. Committed records stay in shared memory when producer (or writer) crashes.
+	* @param[in]	ringName		Shared memory ring name (e.g. "/msvlog").
+	* @param[in]	writer			True when this process writes log files (runs writing thread).
+	* @param[in]	slotCount		Number of ring slots (used by the process which creates the ring).
+	* @param[in]	mode				Access mode of created ring (0600 - owner only, 0660 - owner and group).
+	* @param[in]	group				Group of created ring (-1 keeps group of process).
+	* @param[in]	pushTimeout		Maximum time for which logging waits for free slot when ring is full (or
+	*										writer is not running). Zero (default) drops record without waiting.
+	* @retval		true			When ring was opened (and writer started).
+	* @retval		false			When ring can not be opened or another writer is running.
+	* @note			It is applied to log files used for the first time after this call only.
+	*					Writer writes log files to its own log folder, log file names must be relative to it
+	*					(without "..").
+	*					Writer shares log file pool set by @ref SetMaxOpenLogFiles (when it is set before this call),
+	*					otherwise it limits opened log files by its own pool.
+	* @see			MsvSharedMemoryRing
+	* @see			MsvSharedMemoryLogWriter
+	******************************************************************************************************/
+	bool SetSharedMemoryLogging(const char* ringName, bool writer, size_t slotCount = 4096, mode_t mode = 0600, gid_t group = static_cast<gid_t>(-1), std::chrono::milliseconds pushTimeout = std::chrono::milliseconds(0))
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		try
+		{
+			std::shared_ptr<MsvSharedMemoryRing> spRing(new MsvSharedMemoryRing(ringName, slotCount, mode, group));
+			if (writer)
+			{
+				m_spSharedMemoryWriter.reset(new MsvSharedMemoryLogWriter(spRing, m_logFolder, m_logIndexBlockSize, m_spFilePool));
+			}
+			m_spSharedMemoryRing = spRing;
+			m_sharedMemoryPushTimeout = pushTimeout;
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		return true;
+	}
+#endif // !_WIN32
+
+	/**************************************************************************************************//**
+	* @brief			Set durable flush.
+	* @details		When it is turned on, flush of log file (after records with flush level - error by default,
+	*					or by @ref Sync) returns after records are on disk (fdatasync). Concurrent flushes are
+	*					grouped to one sync. Log files are preallocated in chunks which extend file size, so sync
+	*					does not update file size record by record (opened log file ends with zeros of the chunk,
+	*					they are removed when it is closed or rotated).
+	* @param[in]	durable				True to turn durable flush on, false to turn it off (default).
+	* @param[in]	preallocateSize	Size of log file chunk preallocated ahead of written records (in bytes).
+	* @note			It is applied to log files used for the first time after this call only.
+	* @see			MsvRotatingFileSink::Sync
+	******************************************************************************************************/
+	void SetDurableFlush(bool durable, size_t preallocateSize = 4194304)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		m_durableFlush = durable;
+		m_preallocateSize = durable ? preallocateSize : 0;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Sync log files.
+	* @details	Flushes all log files. When durable flush is turned on, it returns after all records written
+	*				so far are on disk. Log files are flushed without provider lock (getting loggers is not
+	*				blocked by sync).
+	* @retval	true		On success.
+	* @retval	false		When some log file can not be flushed.
+	* @see		SetDurableFlush
+	******************************************************************************************************/
+	bool Sync()
+	{
+		std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks;
+		try
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+			sinks.reserve(m_sharedSinks.size());
+			for (std::unordered_map<std::string, std::shared_ptr<spdlog::sinks::sink>>::value_type& sharedSink : m_sharedSinks)
+			{
+				sinks.push_back(sharedSink.second);
+			}
+		}
+		catch (...)
+		{
+			//exception caught -> log files can not be listed
+			return false;
+		}
+
+		bool result = true;
+		for (std::shared_ptr<spdlog::sinks::sink>& spSink : sinks)
+		{
+			try
+			{
+				spSink->flush();
+			}
+			catch (...)
+			{
+				result = false;
+			}
+		}
+
+		return result;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set maximum number of opened log files.
+	* @details		Log files are shared by loggers with the same log file, but each distinct log file is kept
+	*					opened. When limit is set, the least recently used log file is closed when another one
+	*					is opened and it is opened again with its next record.
+	* @param[in]	maxOpenFiles		Maximum number of opened log files. Zero means no limit (default).
+	* @note			It is applied to log files used for the first time after this call only.
+	* @see			MsvLogFilePool
+	******************************************************************************************************/
+	void SetMaxOpenLogFiles(size_t maxOpenFiles)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		m_spFilePool.reset(maxOpenFiles ? new MsvLogFilePool(maxOpenFiles) : nullptr);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Set admission policy.
+	* @details		Sets global in-flight limit (concurrency cap weighted by record size - records waiting for
+	*					sink lock or being written) and degradation order. When logging volume spikes and the limit
+	*					fills, records are dropped by level (debug first, then info etc.). Error and critical
+	*					records are never dropped. Dropped counts are reported once per report interval (and when
+	*					provider is destroyed) to default log file by logger "MsvLogging" with level warning
+	*					(summary itself is not subject to admission control).
+	* @param[in]	policy		Admission policy. In-flight limit zero turns admission control off (default).
+	* @note			Log files used for the first time before the first policy is set are not controlled. Later
+	*					policy changes (including turning it off) apply to all controlled log files at once.
+	* @see			MsvAdmissionPolicy
+	* @see			MsvAdmissionControlSink
+	******************************************************************************************************/
+	void SetAdmissionPolicy(const MsvAdmissionPolicy& policy)
+	{
+		//reporter thread logs summary (takes lock) -> never stop it when lock is locked
+		std::unique_ptr<MsvAdmissionReporter> spAdmissionReporter;
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_lock);
+			spAdmissionReporter = std::move(m_spAdmissionReporter);
+		}
+		spAdmissionReporter.reset();
+
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		//limiter is never replaced - existing sinks use the new policy and dropped counts are not lost
+		if (m_spAdmissionLimiter)
+		{
+			m_spAdmissionLimiter->SetPolicy(policy);
+		}
+		else if (policy.inFlightLimit)
+		{
+			m_spAdmissionLimiter.reset(new MsvAdmissionLimiter(policy));
+		}
+
+		if (policy.inFlightLimit)
+		{
+			m_spAdmissionReporter.reset(new MsvAdmissionReporter(m_spAdmissionLimiter, policy.reportInterval, [this](const std::string& summary) { LogDroppedSummary(summary); }));
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Apply configuration.
+	* @details		Parses configuration and publishes it as immutable snapshot (atomic pointer swap). Levels
+	*					and flush levels of existing loggers are changed atomically, patterns are read by
+	*					formatters of all log files without any lock. Logging threads are never blocked by reload.
+	*					Sink parameters (maximum log file size and count) are used for new log files only and they
+	*					are changed only when they are present in configuration.
+	* @param[in]	configText		Configuration text (see @ref MsvLoggingConfig for format).
+	* @retval		true				When configuration was applied.
+	* @retval		false				When configuration is not valid (nothing is changed).
+	* @see			MsvLoggingConfig
+	******************************************************************************************************/
+	bool ApplyConfig(const std::string& configText)
+	{
+		MsvLoggingConfig config;
+		if (!MsvLoggingConfig::Parse(configText, config))
+		{
+			return false;
+		}
+
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		config.version = ++m_configVersion;
+		m_logLevel = config.level;
+		if (config.hasMaxLogFileSize)
+		{
+			m_maxLogFileSize = config.maxLogFileSize;
+		}
+		if (config.hasMaxLogFiles)
+		{
+			m_maxLogFiles = config.maxLogFiles;
+		}
+
+		if (m_spConfig)
+		{
+			m_spConfig->Publish(new MsvLoggingConfig(config));
+		}
+		else
+		{
+			//the first configuration -> switch formatters of all log files to configuration formatter
+			m_spConfig.reset(new MsvAtomicSnapshot<MsvLoggingConfig>(new MsvLoggingConfig(config)));
+			for (std::unordered_map<std::string, std::shared_ptr<spdlog::sinks::sink>>::value_type& sharedSink : m_sharedSinks)
+			{
+				sharedSink.second->set_formatter(std::unique_ptr<spdlog::formatter>(new MsvConfigFormatter(m_spConfig)));
+			}
+		}
+
+		for (std::map<std::string, std::shared_ptr<MsvLogger>>::value_type& logger : m_loggers)
+		{
+			logger.second->set_level(config.GetLevel(logger.first));
+			logger.second->flush_on(config.flushLevel);
+		}
+
+		return true;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Load configuration.
+	* @param[in]	configFile		Configuration file name (path).
+	* @retval		true				When configuration was applied.
+	* @retval		false				When configuration file can not be read or it is not valid.
+	* @see			ApplyConfig
+	******************************************************************************************************/
+	bool LoadConfig(const char* configFile)
+	{
+		std::string configText;
+		return MsvConfigFileWatcher::ReadFile(configFile, configText) && ApplyConfig(configText);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Watch configuration.
+	* @details		Loads configuration and starts watching configuration file. Configuration is applied
+	*					again whenever configuration file changes (invalid configuration is ignored).
+	* @param[in]	configFile		Configuration file name (path).
+	* @param[in]	pollInterval	Poll interval (only stop check interval when inotify is available).
+	* @retval		true				When configuration was applied and watching started.
+	* @retval		false				When configuration file can not be read or it is not valid.
+	* @see			ApplyConfig
+	* @see			MsvConfigFileWatcher
+	******************************************************************************************************/
+	bool WatchConfig(const char* configFile, std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000))
+	{
+		if (!LoadConfig(configFile))
+		{
+			return false;
+		}
+
+		//watcher thread applies configuration (takes lock) -> never stop it when lock is locked
+		std::unique_ptr<MsvConfigFileWatcher> spConfigWatcher;
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_lock);
+			spConfigWatcher = std::move(m_spConfigWatcher);
+		}
+		spConfigWatcher.reset(new MsvConfigFileWatcher(configFile, [this](const std::string& configText) { ApplyConfig(configText); }, pollInterval));
+
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		m_spConfigWatcher = std::move(spConfigWatcher);
+
+		return true;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Log dropped records summary.
+	* @details		Logs summary to default log file (its real sink - summary is not dropped by admission
+	*					control). Errors are ignored.
+	* @param[in]	summary		Dropped records summary.
+	* @see			SetAdmissionPolicy
+	******************************************************************************************************/
+	void LogDroppedSummary(const std::string& summary) const
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		try
+		{
+			std::shared_ptr<spdlog::sinks::sink> spSink = GetSharedSink(m_logFile.c_str(), m_maxLogFileSize, m_maxLogFiles);
+			std::shared_ptr<MsvAdmissionControlSink> spAdmissionSink = std::dynamic_pointer_cast<MsvAdmissionControlSink>(spSink);
+			if (spAdmissionSink)
+			{
+				spSink = spAdmissionSink->GetSink();
+			}
+
+			spSink->log(spdlog::details::log_msg("MsvLogging", spdlog::level::warn, summary));
+		}
+		catch (...)
+		{
+			//exception caught -> summary is lost
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get shared sink.
+	* @details		Returns already created sink for log file or creates new one.
+	* @param[in]	logFile			Log file name.
+	* @param[in]	maxLogFileSize	Maximum size of one log file (in bytes).
+	* @param[in]	maxLogFiles		Maximum number of log files (rotating logger, oldest file will be deleted).
+	* @returns		Shared sink for log file.
+	* @throws		spdlog::spdlog_ex	When log file can not be opened.
+	* @warning		Call it only when m_lock is locked.
+	******************************************************************************************************/
+	std::shared_ptr<spdlog::sinks::sink> GetSharedSink(const char* logFile, int maxLogFileSize, int maxLogFiles) const
+	{
+		std::string logFilePath(m_logFolder + "/" + logFile);
+
+		std::unordered_map<std::string, std::shared_ptr<spdlog::sinks::sink>>::const_iterator it = m_sharedSinks.find(logFilePath);
+		if (it != m_sharedSinks.end())
+		{
+			return it->second;
+		}
+
+		std::shared_ptr<spdlog::sinks::sink> spSharedSink(nullptr);
+		size_t logIndexBlockSize = m_logIndexBlockSize;
+		bool durableFlush = m_durableFlush;
+		size_t preallocateSize = m_preallocateSize;
+		std::shared_ptr<MsvLogFilePool> spFilePool = m_spFilePool;
+		MsvLazySink::SinkFactory createSink = [logFilePath, maxLogFileSize, maxLogFiles, logIndexBlockSize, durableFlush, preallocateSize, spFilePool]()
+		{
+			std::shared_ptr<MsvRotatingFileSink> spSink(new MsvRotatingFileSink(logFilePath, maxLogFileSize, maxLogFiles, logIndexBlockSize));
+			spSink->SetDurability(durableFlush, preallocateSize);
+			spSink->SetFilePool(spFilePool);
+			return std::shared_ptr<spdlog::sinks::sink>(spSink);
+		};
+
+#ifndef _WIN32
+		if (m_spSharedMemoryRing)
+		{
+			//records are written by shared memory writer (it opens the log file in its log folder)
+			spSharedSink.reset(new MsvSharedMemorySink(m_spSharedMemoryRing, logFile, maxLogFileSize, maxLogFiles, m_sharedMemoryPushTimeout));
+		}
+		else
+#endif // !_WIN32
+		if (m_lazySinkOpening)
+		{
+			spSharedSink.reset(new MsvLazySink(createSink));
+		}
+		else
+		{
+			spSharedSink = createSink();
+		}
+
+		if (m_spAdmissionLimiter)
+		{
+			spSharedSink.reset(new MsvAdmissionControlSink(spSharedSink, m_spAdmissionLimiter));
+		}
+
+		//pattern is stored in sink (shared by loggers) -> set it just once
+		if (m_spConfig)
+		{
+			spSharedSink->set_formatter(std::unique_ptr<spdlog::formatter>(new MsvConfigFormatter(m_spConfig)));
+		}
+		else
+		{
+			//[2014-31-10 23:46:59.256789123] [processId] [threadId] [loggerName] [severity] "message"
+			//[2014-31-10 23:46:59.256789123] [1111] [2222] [MsvLogger] [info] Some message
+			spSharedSink->set_pattern("[%Y-%m-%d %H:%M:%S.%F] [%P] [%t] [%n] [%l] %v");
+		}
+
+		m_sharedSinks[logFilePath] = spSharedSink;
+		return spSharedSink;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Create logger.
+	* @details		Creates logger with sink, sets its level and flush level (from configuration when it is
+	*					applied) and stores it to loggers of this provider (so it can be found by its name). Logger
+	*					is not registered to spdlog - providers do not share logger names.
+	* @param[in]	loggerName		Logger name which will be included to log file.
+	* @param[in]	spSink			Sink to log to.
+	* @returns		Created logger.
+	* @warning		Call it only when m_lock is locked.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> CreateLogger(const std::string& loggerName, std::shared_ptr<spdlog::sinks::sink> spSink) const
+	{
+		//subscription sink does not get any record while there is no subscription (its level is off)
+		std::shared_ptr<MsvLogger> spLogger(new MsvLogger(loggerName, { spSink, m_spSubscriptionSink }));
+
+		if (m_spConfig)
+		{
+			MsvAtomicSnapshot<MsvLoggingConfig>::Guard config(*m_spConfig);
+			spLogger->set_level(config->GetLevel(loggerName));
+			spLogger->flush_on(config->flushLevel);
+		}
+		else
+		{
+			spLogger->set_level(m_logLevel);
+			spLogger->flush_on(spdlog::level::err);
+		}
+
+		m_loggers[loggerName] = spLogger;
+
+		return spLogger;
 	}
 
 protected:
@@ -183,11 +698,98 @@ protected:
 	******************************************************************************************************/
 	MsvLogLevel m_logLevel;
 
+	/**************************************************************************************************//**
+	* @brief		Log index block size.
+	* @details	Size of indexed block (in bytes). Zero means no index.
+	******************************************************************************************************/
+	size_t m_logIndexBlockSize;
+
+	/**************************************************************************************************//**
+	* @brief		Lazy sink opening.
+	* @details	True when log files are opened with the first logged record.
+	******************************************************************************************************/
+	bool m_lazySinkOpening;
+
+	/**************************************************************************************************//**
+	* @brief		Durable flush.
+	* @details	True when flush syncs log files to disk.
+	******************************************************************************************************/
+	bool m_durableFlush;
+
+	/**************************************************************************************************//**
+	* @brief		Size of log file chunk preallocated ahead of written records (in bytes).
+	******************************************************************************************************/
+	size_t m_preallocateSize;
+
+	/**************************************************************************************************//**
+	* @brief		Log file pool.
+	* @details	Limits number of opened log files (nullptr when it is not limited).
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogFilePool> m_spFilePool;
+
+	/**************************************************************************************************//**
+	* @brief		Admission limiter.
+	* @details	In-flight limit shared by all sinks (nullptr until admission policy is set for the first time).
+	******************************************************************************************************/
+	std::shared_ptr<MsvAdmissionLimiter> m_spAdmissionLimiter;
+
+	/**************************************************************************************************//**
+	* @brief		Admission reporter.
+	* @details	Reports dropped records of admission limiter (nullptr when admission control is turned off).
+	******************************************************************************************************/
+	std::unique_ptr<MsvAdmissionReporter> m_spAdmissionReporter;
+
 	/**************************************************************************************************//**
 	* @brief		Shared sinks.
 	* @details	Already created mutltithreaded sinks.
 	******************************************************************************************************/
-	mutable std::map<std::string, std::shared_ptr<spdlog::sinks::rotating_file_sink_mt>> m_sharedSinks;
+	mutable std::unordered_map<std::string, std::shared_ptr<spdlog::sinks::sink>> m_sharedSinks;
+
+	/**************************************************************************************************//**
+	* @brief		Subscription sink.
+	* @details	Sink of all loggers which passes records to subscriptions.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogSubscriptionSink> m_spSubscriptionSink;
+
+	/**************************************************************************************************//**
+	* @brief		Loggers.
+	* @details	Loggers created (or registered) by this provider by their names (they are found by name and
+	*				configuration is applied to them).
+	******************************************************************************************************/
+	mutable std::map<std::string, std::shared_ptr<MsvLogger>> m_loggers;
+
+	/**************************************************************************************************//**
+	* @brief		Published configuration.
+	* @details	Configuration snapshot read by formatters (nullptr until configuration is applied).
+	******************************************************************************************************/
+	std::shared_ptr<MsvAtomicSnapshot<MsvLoggingConfig>> m_spConfig;
+
+	/**************************************************************************************************//**
+	* @brief		Version of the last published configuration.
+	******************************************************************************************************/
+	uint64_t m_configVersion;
+
+	/**************************************************************************************************//**
+	* @brief		Configuration file watcher (nullptr when configuration file is not watched).
+	******************************************************************************************************/
+	std::unique_ptr<MsvConfigFileWatcher> m_spConfigWatcher;
+
+#ifndef _WIN32
+	/**************************************************************************************************//**
+	* @brief		Shared memory ring (nullptr when shared memory logging is turned off).
+	******************************************************************************************************/
+	std::shared_ptr<MsvSharedMemoryRing> m_spSharedMemoryRing;
+
+	/**************************************************************************************************//**
+	* @brief		Maximum time for which logging waits for free slot of full shared memory ring.
+	******************************************************************************************************/
+	std::chrono::milliseconds m_sharedMemoryPushTimeout;
+
+	/**************************************************************************************************//**
+	* @brief		Shared memory writer (nullptr when this process is not the writer).
+	******************************************************************************************************/
+	std::unique_ptr<MsvSharedMemoryLogWriter> m_spSharedMemoryWriter;
+#endif // !_WIN32
 };
 
 
@@ -266,6 +868,32 @@ public:
 		return spLogger;
 	}
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvLoggerProvider::RegisterLoggers(const std::vector<std::string>&) const
+	******************************************************************************************************/
+	virtual bool RegisterLoggers(const std::vector<std::string>& loggerNames) const override
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		try
+		{
+			for (const std::string& loggerName : loggerNames)
+			{
+				if (!spdlog::get(loggerName))
+				{
+					spdlog::create<spdlog::sinks::null_sink_mt>(loggerName);
+				}
+			}
+		}
+		catch (...)
+		{
+			//exception caught -> some loggers have not been registered
+			return false;
+		}
+
+		return true;
+	}
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvLoggerProvider::SetLogLevel(MsvLogLevel logLevel)
 	******************************************************************************************************/
@@ -275,6 +903,19 @@ public:
 		//null logger does not log anything -> no log level required
 	}
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvLoggerProvider::Subscribe(const char*, MsvLogLevel)
+	******************************************************************************************************/
+	virtual std::shared_ptr<IMsvLogSubscription> Subscribe(const char* loggerName = "", MsvLogLevel logLevel = spdlog::level::trace) override
+	{
+		//unused parameters
+		(void)loggerName;
+		(void)logLevel;
+
+		//null logger does not log anything -> nothing to subscribe to
+		return nullptr;
+	}
+
 protected:
 	/**************************************************************************************************//**
 	* @brief		Locking object.
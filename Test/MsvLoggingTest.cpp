@@ -2,9 +2,19 @@
 
 #include "../MsvSpdLogLoggerProvider.h"
 #include "../MsvLoggingObject.h"
+#include "../MsvLogIndexReader.h"
+#include "../MsvLogTimer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <regex>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif // !_WIN32
 
 
 const char* logFileName = "msvtestlogfile.txt";
@@ -184,6 +194,530 @@ TEST_F(SpdLogLoggerProviderTests, ItShouldBeSameLogger)
 	EXPECT_EQ(m_spLogger, spLogger);
 }
 
+TEST_F(SpdLogLoggerProviderTests, ItShouldFormatMessages_AndSkipArguments_WhenLevelIsNotLogged)
+{
+	const char* formatLogFileName = "msvformattestlogfile.txt";
+	std::string formatLogFilePath = std::string("/") + formatLogFileName;
+	int evaluated = 0;
+	{
+		MsvLoggerProvider loggerProvider("", formatLogFileName);
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvFormatTest");
+
+		MSV_LOG_INFO(spLogger, "no {arguments}");
+		MSV_LOG_INFO(spLogger, "one {}", 1);
+		MSV_LOG_INFO(spLogger, "two {} {:.2f}", "text", 2.5);
+		MSV_LOG_INFO(spLogger, "three {} {:x} {:>4}", std::string("text"), 255, 'c');
+		MSV_LOG_INFO(spLogger, "four {0} {1} {2} {3}", true, -4, 4u, 4ll);
+		MSV_LOG_DEBUG(spLogger, "not logged {}", ++evaluated);
+		spLogger->flush();
+	}
+	EXPECT_EQ(evaluated, 0);
+
+	std::ifstream logFile(formatLogFilePath);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(logFile, line);)
+	{
+		lines.push_back(line.substr(line.find("]: ") + 3));
+	}
+	logFile.close();
+
+	EXPECT_EQ(lines, std::vector<std::string>({ "no {arguments}", "one 1", "two text 2.50", "three text ff    c", "four true -4 4 4" }));
+	EXPECT_EQ(remove(formatLogFilePath.c_str()), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldSkipBlocksWithoutRequestedLevel)
+{
+	const char* indexedLogFileName = "msvindexedtestlogfile.txt";
+	const char* indexFileName = "msvindexedtestlogfile.txt.idx";
+	{
+		MsvLoggerProvider loggerProvider("", indexedLogFileName);
+		loggerProvider.SetLogIndexBlockSize(256);
+
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvIndexTest");
+		spLogger->set_level(spdlog::level::trace);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			MSV_LOG_DEBUG(spLogger, "message {}", i);
+		}
+		MSV_LOG_ERROR(spLogger, "error message");
+		for (int i = 0; i < 100; ++i)
+		{
+			MSV_LOG_DEBUG(spLogger, "message {}", i);
+		}
+	}
+
+	MsvLogIndexReader reader(std::string("/") + indexedLogFileName);
+	EXPECT_TRUE(reader.Load());
+	EXPECT_GT(reader.GetEntries().size(), 10);
+
+	std::vector<std::string> allLines = reader.ReadLines(spdlog::log_clock::time_point::min(), spdlog::log_clock::time_point::max());
+	EXPECT_EQ(allLines.size(), 201);
+
+	std::vector<std::string> errorLines = reader.ReadLines(spdlog::log_clock::time_point::min(), spdlog::log_clock::time_point::max(), spdlog::level::err);
+	EXPECT_LT(errorLines.size(), 10);
+	EXPECT_EQ(std::count_if(errorLines.begin(), errorLines.end(), [](const std::string& line) { return line.find("[error]") != std::string::npos; }), 1);
+
+	EXPECT_TRUE(reader.ReadLines(spdlog::log_clock::now() + std::chrono::hours(1), spdlog::log_clock::time_point::max()).empty());
+
+	EXPECT_EQ(remove((std::string("/") + indexedLogFileName).c_str()), 0);
+	EXPECT_EQ(remove((std::string("/") + indexFileName).c_str()), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldOpenLogFileWithTheFirstRecord_WhenLazySinkOpening)
+{
+	const char* lazyLogFileName = "msvlazytestlogfile.txt";
+	std::string lazyLogFilePath = std::string("/") + lazyLogFileName;
+	{
+		MsvLoggerProvider loggerProvider("", lazyLogFileName);
+		loggerProvider.SetLazySinkOpening(true);
+
+		EXPECT_TRUE(loggerProvider.RegisterLoggers({ "MsvLazyTest1", "MsvLazyTest2", "MsvLazyTest3" }));
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvLazyTest2");
+		EXPECT_EQ(spLogger, loggerProvider.GetLogger("MsvLazyTest2"));
+
+		MSV_LOG_DEBUG(spLogger, "message");
+		EXPECT_FALSE(std::ifstream(lazyLogFilePath).good());
+
+		MSV_LOG_ERROR(spLogger, "message");
+		EXPECT_TRUE(std::ifstream(lazyLogFilePath).good());
+
+		//loggers of another provider with the same name are not shared
+		MsvLoggerProvider otherLoggerProvider("", lazyLogFileName);
+		EXPECT_NE(spLogger, otherLoggerProvider.GetLogger("MsvLazyTest2"));
+	}
+
+	EXPECT_EQ(remove(lazyLogFilePath.c_str()), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldReportScopeTimerSummary)
+{
+	auto record = [this](int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			MSV_LOG_SCOPE_TIMER(m_spLogger, "MsvTestTimer");
+		}
+	};
+
+	//histograms of ended threads are merged (and reused)
+	record(100);
+	std::thread(record, 50).join();
+	std::thread(record, 50).join();
+
+	MsvLogTimerRegistry::Get().Report();
+	//nothing recorded since last report -> no summary line
+	MsvLogTimerRegistry::Get().Report();
+	m_spLogger->flush();
+
+	std::ifstream logFile(logFileName);
+	std::vector<std::string> lines;
+
+	std::string line;
+	while (std::getline(logFile, line))
+	{
+		lines.push_back(line);
+	}
+
+	EXPECT_EQ(lines.size(), 1);
+	EXPECT_TRUE(std::regex_match(lines[0], std::regex(".* \\[info\\] timer MsvTestTimer: count 200, min [0-9]+ ns, p50 [0-9]+ ns, p99 [0-9]+ ns, max [0-9]+ ns")));
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldDropLowLevelsAndKeepErrors_WhenInFlightLimitIsFull)
+{
+	const char* admissionLogFileName = "msvadmissiontestlogfile.txt";
+	std::string admissionLogFilePath = std::string("/") + admissionLogFileName;
+	{
+		MsvAdmissionPolicy policy(1048576);
+		MsvLoggerProvider loggerProvider("", admissionLogFileName);
+		loggerProvider.SetAdmissionPolicy(policy);
+
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvAdmissionTest");
+		spLogger->set_level(spdlog::level::trace);
+		MSV_LOG_DEBUG(spLogger, "admitted");
+
+		//new policy is used by already opened log file
+		policy.inFlightLimit = 1;
+		loggerProvider.SetAdmissionPolicy(policy);
+
+		MSV_LOG_DEBUG(spLogger, "message");
+		MSV_LOG_INFO(spLogger, "message");
+		MSV_LOG_INFO(spLogger, "message");
+		MSV_LOG_ERROR(spLogger, "message");
+		MSV_LOG_CRITICAL(spLogger, "message");
+	}
+
+	std::ifstream logFile(admissionLogFilePath);
+	std::vector<std::string> lines;
+
+	std::string line;
+	while (std::getline(logFile, line))
+	{
+		lines.push_back(line);
+	}
+	logFile.close();
+
+	ASSERT_EQ(lines.size(), 4);
+	//summary is reported when provider is destroyed (report interval has not elapsed)
+	EXPECT_TRUE(std::regex_match(lines[0], std::regex(".* \\[MsvAdmissionTest\\] \\[debug\\] .*admitted")));
+	EXPECT_TRUE(std::regex_match(lines[1], std::regex(".* \\[MsvAdmissionTest\\] \\[error\\] .*")));
+	EXPECT_TRUE(std::regex_match(lines[2], std::regex(".* \\[MsvAdmissionTest\\] \\[critical\\] .*")));
+	EXPECT_TRUE(std::regex_match(lines[3], std::regex(".* \\[MsvLogging\\] \\[warning\\] dropped records: trace 0, debug 1, info 2, warning 0")));
+
+	EXPECT_EQ(remove(admissionLogFilePath.c_str()), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldReloadConfig_UnderLoggingLoad)
+{
+	const char* configLogFileName = "msvconfigtestlogfile.txt";
+	std::string configLogFilePath = std::string("/") + configLogFileName;
+	{
+		MsvLoggerProvider loggerProvider("", configLogFileName);
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvConfigTest");
+
+		std::atomic<bool> stop(false);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 4; ++i)
+		{
+			threads.emplace_back([&stop, spLogger]()
+			{
+				while (!stop)
+				{
+					MSV_LOG_DEBUG(spLogger, "message");
+					MSV_LOG_INFO(spLogger, "message");
+				}
+			});
+		}
+
+		for (int i = 0; i < 200; ++i)
+		{
+			EXPECT_TRUE(loggerProvider.ApplyConfig(i % 2 ? "level = debug\nlogger.MsvConfigTest.pattern = [%l] %v" : "level = warning\nmax_log_files = 1"));
+			std::this_thread::sleep_for(std::chrono::microseconds(500));
+		}
+
+		stop = true;
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		EXPECT_FALSE(loggerProvider.ApplyConfig("level = loud"));
+		EXPECT_FALSE(loggerProvider.ApplyConfig("max_log_file_size = 10MB"));
+		EXPECT_FALSE(loggerProvider.ApplyConfig("max_log_files = -1"));
+		EXPECT_TRUE(loggerProvider.ApplyConfig("# final configuration\nlogger.MsvConfigTest.level = error\nlogger.MsvConfigTest.pattern = CFG %v"));
+		EXPECT_EQ(spLogger->level(), spdlog::level::err);
+
+		loggerProvider.SetLogLevel(spdlog::level::warn);
+		EXPECT_EQ(spLogger->level(), spdlog::level::warn);
+		EXPECT_EQ(loggerProvider.GetLogger("MsvConfigLevelTest")->level(), spdlog::level::warn);
+
+		MSV_LOG_WARN(spLogger, "warning");
+		MSV_LOG_ERROR(spLogger, "final");
+	}
+
+	std::ifstream logFile(configLogFilePath);
+	std::string line, lastLine;
+	while (std::getline(logFile, line))
+	{
+		lastLine = line;
+	}
+	logFile.close();
+
+	EXPECT_TRUE(std::regex_match(lastLine, std::regex("CFG \\[[^\\]]*:[0-9]{1,4}\\]: final")));
+
+	EXPECT_EQ(remove(configLogFilePath.c_str()), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldApplyConfig_WhenConfigFileChanges)
+{
+	const char* configFileName = "msvtestconfig.txt";
+	std::ofstream(configFileName) << "level = info\n";
+
+	MsvLoggerProvider loggerProvider("", "msvconfigwatchtestlogfile.txt");
+	loggerProvider.SetLazySinkOpening(true);
+	EXPECT_TRUE(loggerProvider.WatchConfig(configFileName, std::chrono::milliseconds(10)));
+
+	std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvConfigWatchTest");
+	EXPECT_EQ(spLogger->level(), spdlog::level::info);
+
+	std::ofstream(configFileName) << "level = info\nlogger.MsvConfigWatchTest.level = critical\n";
+	for (int i = 0; i < 500 && spLogger->level() != spdlog::level::critical; ++i)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	EXPECT_EQ(spLogger->level(), spdlog::level::critical);
+
+	//empty (truncated) and invalid configuration must not reset configuration
+	std::ofstream(configFileName).close();
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	EXPECT_EQ(spLogger->level(), spdlog::level::critical);
+	std::ofstream(configFileName) << "level = info\nlogger.MsvConfigWatchTest.level = loud\n";
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	EXPECT_EQ(spLogger->level(), spdlog::level::critical);
+
+	EXPECT_EQ(remove(configFileName), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldWriteAllRecords_WhenDurableFlushIsGroupedByThreads)
+{
+	const char* durableLogFileName = "msvdurabletestlogfile.txt";
+	std::string durableLogFilePath = std::string("/") + durableLogFileName;
+	{
+		MsvLoggerProvider loggerProvider("", durableLogFileName);
+		loggerProvider.SetDurableFlush(true, 65536);
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvDurableTest");
+
+		std::vector<std::thread> threads;
+		for (int thread = 0; thread < 8; ++thread)
+		{
+			threads.emplace_back([spLogger, thread]()
+			{
+				for (int i = 0; i < 50; ++i)
+				{
+					spLogger->error("thread {} record {}", thread, i);
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		spLogger->info("last record");
+		EXPECT_TRUE(loggerProvider.Sync());
+	}
+
+	//preallocated blocks must not be visible (as zeros) at the end of log file
+
+	std::ifstream logFile(durableLogFilePath);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(logFile, line);)
+	{
+		lines.push_back(line);
+	}
+	logFile.close();
+
+	ASSERT_EQ(lines.size(), 401u);
+	EXPECT_EQ(std::count_if(lines.begin(), lines.end(), [](const std::string& line) { return line.find("[error] thread ") != std::string::npos; }), 400);
+	EXPECT_NE(lines.back().find("last record"), std::string::npos);
+	EXPECT_EQ(remove(durableLogFilePath.c_str()), 0);
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldLimitOpenedLogFiles_AndReopenEvictedOnes)
+{
+	std::shared_ptr<MsvLogFilePool> spFilePool(new MsvLogFilePool(4));
+	std::vector<std::shared_ptr<MsvLogger>> loggers;
+	for (int tenant = 0; tenant < 20; ++tenant)
+	{
+		std::shared_ptr<MsvRotatingFileSink> spSink(new MsvRotatingFileSink("/msvpooltestlogfile" + std::to_string(tenant) + ".txt", 1048576, 1));
+		spSink->set_pattern("%v");
+		spSink->SetFilePool(spFilePool);
+		loggers.emplace_back(new MsvLogger("MsvPoolTest", spSink));
+		EXPECT_LE(spFilePool->GetOpenCount(), 4u);
+	}
+
+	for (int round = 0; round < 3; ++round)
+	{
+		for (std::shared_ptr<MsvLogger>& spLogger : loggers)
+		{
+			spLogger->info("round {}", round);
+			EXPECT_LE(spFilePool->GetOpenCount(), 4u);
+		}
+	}
+	EXPECT_GE(spFilePool->GetEvictions(), 16u);
+
+	//evicted log file is synced without opening it in pool
+	EXPECT_NO_THROW(std::static_pointer_cast<MsvRotatingFileSink>(loggers.front()->sinks().front())->Sync());
+	EXPECT_LE(spFilePool->GetOpenCount(), 4u);
+	loggers.clear();
+	EXPECT_EQ(spFilePool->GetOpenCount(), 0u);
+
+	for (int tenant = 0; tenant < 20; ++tenant)
+	{
+		std::string logFilePath = "/msvpooltestlogfile" + std::to_string(tenant) + ".txt";
+		std::ifstream logFile(logFilePath);
+		std::string content((std::istreambuf_iterator<char>(logFile)), std::istreambuf_iterator<char>());
+		logFile.close();
+
+		EXPECT_EQ(content, "round 0" + std::string(spdlog::details::os::default_eol) + "round 1" + spdlog::details::os::default_eol + "round 2" + spdlog::details::os::default_eol);
+		EXPECT_EQ(remove(logFilePath.c_str()), 0);
+	}
+}
+
+TEST_F(SpdLogLoggerProviderTests, ItShouldReceiveSubscribedRecords_AndCountGap_WhenSubscriberIsSlow)
+{
+	EXPECT_EQ(MsvNullLoggerProvider().Subscribe(), nullptr);
+
+	std::shared_ptr<MsvLogger> spOtherLogger = m_spLoggerProvider->GetLogger("MsvSubscriptionTest");
+	std::shared_ptr<IMsvLogSubscription> spSubscription = m_spLoggerProvider->Subscribe(loggerName, spdlog::level::warn);
+	ASSERT_NE(spSubscription, nullptr);
+
+	MSV_LOG_INFO(m_spLogger, "filtered by level");
+	MSV_LOG_WARN(spOtherLogger, "filtered by logger");
+	MSV_LOG_WARN(m_spLogger, "record {}", 1);
+	int line = __LINE__ - 1;
+
+	MsvLogRecord record;
+	ASSERT_TRUE(spSubscription->Poll(record));
+	EXPECT_EQ(record.level, spdlog::level::warn);
+	EXPECT_EQ(record.logger, loggerName);
+	EXPECT_NE(record.file.find("MsvLoggingTest.cpp"), std::string::npos);
+	EXPECT_EQ(record.line, line);
+	EXPECT_NE(record.function.find("TestBody"), std::string::npos);
+	EXPECT_EQ(record.payload, "record 1");
+	EXPECT_FALSE(spSubscription->Poll(record));
+
+	//location is parsed from prefix of message logged by logger directly
+	m_spLogger->warn("[Direct.cpp:12]: record {}", 2);
+	ASSERT_TRUE(spSubscription->Poll(record));
+	EXPECT_EQ(record.file, "Direct.cpp");
+	EXPECT_EQ(record.line, 12);
+	EXPECT_TRUE(record.function.empty());
+	EXPECT_EQ(record.payload, "record 2");
+	EXPECT_EQ(record.gap, 0u);
+	EXPECT_FALSE(spSubscription->Poll(record));
+
+	//concurrent producers - records of each thread are received in order (or counted as lost)
+	std::atomic<int> running(4);
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 4; ++thread)
+	{
+		threads.emplace_back([this, thread, &running]()
+		{
+			for (int i = 0; i < 5000; ++i)
+			{
+				m_spLogger->warn("{} {}", thread, i);
+			}
+			--running;
+		});
+	}
+
+	uint64_t received = 0;
+	uint64_t gap = 0;
+	int lastRecords[4] = { -1, -1, -1, -1 };
+	auto pollRecords = [&]()
+	{
+		while (spSubscription->Poll(record))
+		{
+			int thread = 0;
+			int i = 0;
+			ASSERT_EQ(sscanf(record.payload.c_str(), "%d %d", &thread, &i), 2);
+			EXPECT_GT(i, lastRecords[thread]);
+			lastRecords[thread] = i;
+			gap += record.gap;
+			++received;
+		}
+	};
+	while (running)
+	{
+		pollRecords();
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	pollRecords();
+	EXPECT_EQ(received + gap, 20000u);
+	EXPECT_EQ(spSubscription->GetLostCount(), gap);
+
+	//slow subscriber loses the oldest records, producers are not slowed down
+	for (int i = 0; i < 10000; ++i)
+	{
+		m_spLogger->warn("0 {}", 5000 + i);
+	}
+	received = 0;
+	gap = 0;
+	pollRecords();
+	EXPECT_GT(gap, 0u);
+	EXPECT_EQ(received + gap, 10000u);
+	EXPECT_EQ(lastRecords[0], 14999);
+}
+
+#ifndef _WIN32
+TEST_F(SpdLogLoggerProviderTests, ItShouldWriteRecordsOfCrashedProducer_WhenSharedMemoryWriterStarts)
+{
+	const char* ringName = "/msvtestring";
+	std::string logFilePath = std::string("/") + "msvshmtestlogfile.txt";
+	MsvSharedMemoryRing::Remove(ringName);
+
+	pid_t producer = fork();
+	if (producer == 0)
+	{
+		MsvLoggerProvider loggerProvider("", "msvshmtestlogfile.txt");
+		if (!loggerProvider.SetSharedMemoryLogging(ringName, false, 64))
+		{
+			_exit(1);
+		}
+
+		std::shared_ptr<MsvLogger> spLogger = loggerProvider.GetLogger("MsvSharedMemoryProducer");
+		for (int i = 0; i < 10; ++i)
+		{
+			spLogger->info("record {}", i);
+		}
+
+		//crash without any cleanup
+		abort();
+	}
+
+	int status = 0;
+	EXPECT_EQ(waitpid(producer, &status, 0), producer);
+	EXPECT_TRUE(WIFSIGNALED(status));
+
+	{
+		MsvLoggerProvider loggerProvider("", "msvshmtestlogfile.txt");
+		EXPECT_TRUE(loggerProvider.SetSharedMemoryLogging(ringName, true));
+
+		//only one writer can run
+		MsvLoggerProvider secondLoggerProvider("", "msvshmtestlogfile.txt");
+		EXPECT_FALSE(secondLoggerProvider.SetSharedMemoryLogging(ringName, true));
+
+		loggerProvider.GetLogger("MsvSharedMemoryWriter")->info("record 10");
+	}
+
+	std::ifstream logFile(logFilePath);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(logFile, line);)
+	{
+		lines.push_back(line);
+	}
+	logFile.close();
+
+	ASSERT_EQ(lines.size(), 11u);
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		EXPECT_NE(lines[i].find(i < 10 ? "[MsvSharedMemoryProducer]" : "[MsvSharedMemoryWriter]"), std::string::npos);
+		EXPECT_NE(lines[i].find("record " + std::to_string(i)), std::string::npos);
+	}
+
+	//log file names from shared memory must stay in log folder of writer
+	std::string resolvedLogFile;
+	EXPECT_TRUE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "tenant/log.txt", resolvedLogFile));
+	EXPECT_EQ(resolvedLogFile, "logs/tenant/log.txt");
+	EXPECT_TRUE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "./tenant//log.txt", resolvedLogFile));
+	EXPECT_EQ(resolvedLogFile, "logs/tenant/log.txt");
+	EXPECT_FALSE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "./", resolvedLogFile));
+	EXPECT_FALSE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "tenant\\..\\..\\log.txt", resolvedLogFile));
+	EXPECT_FALSE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "/etc/passwd", resolvedLogFile));
+	EXPECT_FALSE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "../log.txt", resolvedLogFile));
+	EXPECT_FALSE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "tenant/../../log.txt", resolvedLogFile));
+	EXPECT_FALSE(MsvSharedMemoryLogWriter::ResolveLogFile("logs", "tenant/..", resolvedLogFile));
+
+	MsvSharedMemoryRing::Remove(ringName);
+	EXPECT_EQ(remove(logFilePath.c_str()), 0);
+}
+#endif // !_WIN32
+
+TEST(MsvLogHistogramTests, ItShouldMapValuesToBucketsWithinBounds)
+{
+	for (uint64_t value : { 0ull, 1ull, 15ull, 16ull, 31ull, 32ull, 1000ull, 123456789ull, 1ull << 40 })
+	{
+		size_t bucket = MsvLogHistogram::GetBucket(value);
+
+		EXPECT_LE(MsvLogHistogram::GetBucketLowerBound(bucket), value);
+		EXPECT_GE(MsvLogHistogram::GetBucketUpperBound(bucket), value);
+	}
+}
+
 TEST_F(MsvLoggingObjectTests, ItShouldBeSameLogger_InLoggingObjectByLoggerProvider)
 {
 	TestLoggingObject loggingObject(m_spLoggerProvider, loggerName);
@@ -30,6 +30,12 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 MSV_DISABLE_ALL_WARNINGS
 
 #include "spdlog/spdlog.h"
+#ifndef SPDLOG_USE_STD_FORMAT
+#include "spdlog/fmt/compile.h"
+#endif
+
+#include <iterator>
+#include <utility>
 
 MSV_ENABLE_WARNINGS
 
@@ -47,6 +53,7 @@ typedef spdlog::logger MsvLogger;
 typedef spdlog::level::level_enum MsvLogLevel;
 
 
+#include "IMsvLogSubscription.h"
 #include "IMsvLoggerProvider.h"
 
 
@@ -64,14 +71,174 @@ typedef spdlog::level::level_enum MsvLogLevel;
 ******************************************************************************************************/
 #define MSV_STRINGIFY_(stringify) #stringify
 
+/**************************************************************************************************//**
+* @def			MSV_LOG_LOCATION
+* @brief			Source location of log macro call site.
+* @details		Passed to logger with each record, so sinks (e.g. live subscription) get file, line and
+*					function without parsing "[file:line]: " prefix of message.
+******************************************************************************************************/
+#define MSV_LOG_LOCATION spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}
+
+
+/**************************************************************************************************//**
+* @def			MSV_LOG_COLD
+* @brief			Cold function attribute.
+* @details		Function is never inlined and it is placed out of hot code (GCC and Clang).
+******************************************************************************************************/
+/**************************************************************************************************//**
+* @def			MSV_LOG_UNLIKELY(condition)
+* @brief			Unlikely condition.
+* @details		Hints compiler that condition is usually false (code of its branch is moved out of hot path).
+******************************************************************************************************/
+#if defined(__GNUC__) || defined(__clang__)
+#define MSV_LOG_COLD __attribute__((cold, noinline))
+#define MSV_LOG_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#elif defined(_MSC_VER)
+#define MSV_LOG_COLD __declspec(noinline)
+#define MSV_LOG_UNLIKELY(condition) (condition)
+#else
+#define MSV_LOG_COLD
+#define MSV_LOG_UNLIKELY(condition) (condition)
+#endif
+
+
+#ifndef SPDLOG_USE_STD_FORMAT
+/**************************************************************************************************//**
+* @brief			Log message out of line.
+* @details		Formats message and logs it. It is cold and not inlined function (it is not template) -
+*					all log macros share its code, so their call sites contain just level check and call.
+* @param[in]	logger		Logger.
+* @param[in]	location		Source location.
+* @param[in]	level			Log level.
+* @param[in]	format		Format string (checked at compile time by log macros).
+* @param[in]	args			Type-erased format arguments.
+* @note			Like spdlog, logging never throws.
+* @see			MSV_LOG
+******************************************************************************************************/
+MSV_LOG_COLD inline void MsvLogOutOfLine(MsvLogger& logger, spdlog::source_loc location, MsvLogLevel level, fmt::string_view format, fmt::format_args args)
+{
+	try
+	{
+		spdlog::memory_buf_t buffer;
+		fmt::vformat_to(std::back_inserter(buffer), format, args);
+		logger.log(location, level, spdlog::string_view_t(buffer.data(), buffer.size()));
+	}
+	catch (...)
+	{
+	}
+}
+
+/**************************************************************************************************//**
+* @brief			Log message without arguments out of line.
+* @details		Message without arguments is not formatted (as in spdlog), it is logged as it is.
+* @param[in]	logger		Logger.
+* @param[in]	location		Source location.
+* @param[in]	level			Log level.
+* @param[in]	message		Message.
+* @see			MSV_LOG
+******************************************************************************************************/
+MSV_LOG_COLD inline void MsvLogOutOfLine(MsvLogger& logger, spdlog::source_loc location, MsvLogLevel level, fmt::string_view message)
+{
+	try
+	{
+		logger.log(location, level, spdlog::string_view_t(message.data(), message.size()));
+	}
+	catch (...)
+	{
+	}
+}
+
+/**************************************************************************************************//**
+* @brief			Pack arguments and log message out of line.
+* @details		Format string is checked against arguments at compile time (FMT_STRING), arguments are
+*					packed to type-erased array and passed to @ref MsvLogOutOfLine. This small inline function
+*					is the only code instantiated for call site.
+* @param[in]	logger		Logger.
+* @param[in]	location		Source location.
+* @param[in]	level			Log level.
+* @param[in]	format		Checked format string.
+* @param[in]	args			Format arguments.
+* @see			MSV_LOG
+******************************************************************************************************/
+template<typename... Args>
+inline void MsvLogPacked(MsvLogger& logger, spdlog::source_loc location, MsvLogLevel level, fmt::format_string<Args...> format, Args&&... args)
+{
+	MsvLogOutOfLine(logger, location, level, format, fmt::make_format_args(args...));
+}
+
+/**************************************************************************************************//**
+* @brief			Log message without arguments out of line.
+* @param[in]	logger		Logger.
+* @param[in]	location		Source location.
+* @param[in]	level			Log level.
+* @param[in]	format		Format string (logged as it is).
+* @see			MSV_LOG
+******************************************************************************************************/
+template<typename Format>
+inline void MsvLogPacked(MsvLogger& logger, spdlog::source_loc location, MsvLogLevel level, const Format& format)
+{
+	MsvLogOutOfLine(logger, location, level, fmt::string_view(format));
+}
+
+/**************************************************************************************************//**
+* @brief			Log message with compiled format.
+* @details		Formats message by format compiled at compile time (no format string parsing at runtime)
+*					and logs it. It is called by log macros after level check when MSV_LOG_COMPILED_FORMAT
+*					is defined. It is cold and not inlined, but it is instantiated for each call site (each
+*					compiled format is distinct type).
+* @param[in]	logger		Logger.
+* @param[in]	location		Source location.
+* @param[in]	level			Log level.
+* @param[in]	format		Compiled format (FMT_COMPILE).
+* @param[in]	args			Format arguments.
+* @note			Like spdlog, logging never throws.
+* @see			MSV_LOG
+******************************************************************************************************/
+template<typename CompiledFormat, typename... Args>
+MSV_LOG_COLD void MsvLogCompiled(MsvLogger& logger, spdlog::source_loc location, MsvLogLevel level, const CompiledFormat& format, Args&&... args)
+{
+	try
+	{
+		spdlog::memory_buf_t buffer;
+		fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+		logger.log(location, level, spdlog::string_view_t(buffer.data(), buffer.size()));
+	}
+	catch (...)
+	{
+	}
+}
 
+/**************************************************************************************************//**
+* @brief			Log message without arguments.
+* @details		Message without arguments is not formatted (as in spdlog), it is logged as it is.
+* @param[in]	logger		Logger.
+* @param[in]	location		Source location.
+* @param[in]	level			Log level.
+* @param[in]	format		Compiled format (FMT_COMPILE).
+* @see			MSV_LOG
+******************************************************************************************************/
+template<typename CompiledFormat>
+inline void MsvLogCompiled(MsvLogger& logger, spdlog::source_loc location, MsvLogLevel level, const CompiledFormat& format)
+{
+	MsvLogOutOfLine(logger, location, level, fmt::string_view(format));
+}
+
+
+#ifndef MSV_LOG_COMPILED_FORMAT
 /**************************************************************************************************//**
 * @def			MSV_LOG(msvLogger, msvSeverity, msg, ...)
 * @brief			Base log macro.
-* @details		Base log macro used by log macros with severity.
+* @details		Base log macro used by log macros with severity. It expands to unlikely level check and
+*					call of cold out of line function with type-erased arguments (small call site, hot code
+*					is not bloated by logging). Number and types of arguments are checked at compile time
+*					(malformed format string fails the build). Arguments are not evaluated when severity is
+*					not logged.
+*					Define MSV_LOG_COMPILED_FORMAT to format by format compiled for each call site - formatting
+*					is faster (about 30% on short messages), but each call site instantiates its own formatting
+*					function (several hundreds bytes to a few kilobytes of cold code per call site).
 * @param[in]	msvLogger	Logger.
-* @param[in]	msvSeverity	Log severity.
-* @param[in]	msg			Log formated message.
+* @param[in]	msvSeverity	Log severity (spdlog::level::level_enum value name).
+* @param[in]	msg			Log formated message (string literal).
 * @warning		Do not use this macro directly for logging. Use one of macros below.
 * @see			MSV_LOG_DEBUG
 * @see			MSV_LOG_INFO
@@ -79,7 +246,35 @@ typedef spdlog::level::level_enum MsvLogLevel;
 * @see			MSV_LOG_ERROR
 * @see			MSV_LOG_CRITICAL
 ******************************************************************************************************/
-#define MSV_LOG(msvLogger, msvSeverity, msg, ...) if (msvLogger) { msvLogger->msvSeverity("["__FILE__ ":" MSV_STRINGIFY(__LINE__) "]: " msg, __VA_ARGS__); }
+#define MSV_LOG(msvLogger, msvSeverity, msg, ...) if (MSV_LOG_UNLIKELY(msvLogger && msvLogger->should_log(spdlog::level::msvSeverity))) { MsvLogPacked(*msvLogger, MSV_LOG_LOCATION, spdlog::level::msvSeverity, FMT_STRING("[" __FILE__ ":" MSV_STRINGIFY(__LINE__) "]: " msg), __VA_ARGS__); }
+#else
+/**************************************************************************************************//**
+* @def			MSV_LOG(msvLogger, msvSeverity, msg, ...)
+* @brief			Base log macro.
+* @details		Base log macro used by log macros with severity. Format string is compiled (FMT_COMPILE) -
+*					number and types of arguments are checked at compile time (malformed format string fails
+*					the build) and it is not parsed at runtime. Arguments are not evaluated when severity
+*					is not logged. Formatting function is instantiated for each call site (larger code).
+* @param[in]	msvLogger	Logger.
+* @param[in]	msvSeverity	Log severity (spdlog::level::level_enum value name).
+* @param[in]	msg			Log formated message (string literal).
+* @warning		Do not use this macro directly for logging. Use one of macros below.
+******************************************************************************************************/
+#define MSV_LOG(msvLogger, msvSeverity, msg, ...) if (MSV_LOG_UNLIKELY(msvLogger && msvLogger->should_log(spdlog::level::msvSeverity))) { MsvLogCompiled(*msvLogger, MSV_LOG_LOCATION, spdlog::level::msvSeverity, FMT_COMPILE("[" __FILE__ ":" MSV_STRINGIFY(__LINE__) "]: " msg), __VA_ARGS__); }
+#endif // !MSV_LOG_COMPILED_FORMAT
+#else
+/**************************************************************************************************//**
+* @def			MSV_LOG(msvLogger, msvSeverity, msg, ...)
+* @brief			Base log macro.
+* @details		Base log macro used by log macros with severity (std::format is used by spdlog, format
+*					string is checked at compile time, but it is parsed at runtime).
+* @param[in]	msvLogger	Logger.
+* @param[in]	msvSeverity	Log severity (spdlog::level::level_enum value name).
+* @param[in]	msg			Log formated message (string literal).
+* @warning		Do not use this macro directly for logging. Use one of macros below.
+******************************************************************************************************/
+#define MSV_LOG(msvLogger, msvSeverity, msg, ...) if (msvLogger) { msvLogger->log(MSV_LOG_LOCATION, spdlog::level::msvSeverity, "[" __FILE__ ":" MSV_STRINGIFY(__LINE__) "]: " msg, __VA_ARGS__); }
+#endif // !SPDLOG_USE_STD_FORMAT
 
 /**************************************************************************************************//**
 * @def			MSV_LOG_DEBUG(msvLogger, msg, ...)
@@ -117,7 +312,7 @@ typedef spdlog::level::level_enum MsvLogLevel;
 * @param[in]	msg			Log formated message.
 * @note			Default flush severity is error - message will be written to file immediatelly.
 ******************************************************************************************************/
-#define MSV_LOG_ERROR(msvLogger, msg, ...) MSV_LOG(msvLogger, error, msg, __VA_ARGS__)
+#define MSV_LOG_ERROR(msvLogger, msg, ...) MSV_LOG(msvLogger, err, msg, __VA_ARGS__)
 
 /**************************************************************************************************//**
 * @def			MSV_LOG_CRITICAL(msvLogger, msg, ...)